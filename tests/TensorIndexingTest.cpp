@@ -0,0 +1,86 @@
+#include <vkpp/Compute/TensorIndexing.h>
+#include <vkpp/Core/PhysicalDevice.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace vkpp;
+
+constexpr int SkipReturnCode = 77;
+
+template <typename T>
+rad::Ref<Tensor> CreateTensor(Context* context, Tensor::DataType dataType, const std::vector<T>& values)
+{
+    rad::Ref<Tensor> tensor = Tensor::CreateTensor(context, dataType, { uint64_t(values.size()) });
+    context->WriteBuffer(tensor->m_buffer.get(), values.data(),
+        tensor->m_bufferOffset, values.size() * sizeof(T));
+    return tensor;
+}
+
+// Scatter-add of duplicate indices into an output smaller than a 32-bit word per element:
+// the elements sharing a word with the ones updated must be preserved.
+template <typename T>
+bool TestScatterAdd(Context* context, TensorIndexing* indexing, Tensor::DataType dataType, const char* name)
+{
+    const std::vector<T> outputValues = { 1, 2, 3, 4, 5, 6, 7 };
+    const std::vector<int32_t> indexValues = { 0, 1, 2, 0, 1, 2, 5, 9 };
+    const std::vector<T> sourceValues = { 10, -20, 30, -40, 50, 60, -70, 80 };
+    // Index 9 is out of range: ignored.
+    const std::vector<T> expectedValues = { -29, 32, 93, 4, 5, -64, 7 };
+
+    rad::Ref<Tensor> output = CreateTensor(context, dataType, outputValues);
+    rad::Ref<Tensor> index = CreateTensor(context, Tensor::DataType::Sint32, indexValues);
+    rad::Ref<Tensor> source = CreateTensor(context, dataType, sourceValues);
+    if (!indexing->Scatter(output.get(), 0, index.get(), source.get(), TensorIndexing::ScatterReduce::Add))
+    {
+        std::printf("%s: failed to run\n", name);
+        return false;
+    }
+
+    std::vector<T> results(outputValues.size());
+    context->ReadBuffer(output->m_buffer.get(), results.data(),
+        output->m_bufferOffset, results.size() * sizeof(T));
+    bool passed = true;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (results[i] != expectedValues[i])
+        {
+            std::printf("%s: output[%zu] = %d, expected %d\n", name, i,
+                int(results[i]), int(expectedValues[i]));
+            passed = false;
+        }
+    }
+    std::printf("%s: %s\n", name, passed ? "passed" : "failed");
+    return passed;
+}
+
+int main(int argc, char* argv[])
+{
+    rad::Ref<Instance> instance = RAD_NEW Instance();
+    if (!instance->Init("TensorIndexingTest", VK_MAKE_VERSION(0, 0, 0)))
+    {
+        std::printf("Vulkan is not available: skipped.\n");
+        return SkipReturnCode;
+    }
+    rad::Ref<Context> context = RAD_NEW Context();
+    if (!context->Init(instance, nullptr))
+    {
+        std::printf("No Vulkan device: skipped.\n");
+        return SkipReturnCode;
+    }
+    const PhysicalDevice* physicalDevice = context->GetDevice()->GetPhysicalDevice();
+    if ((physicalDevice->m_vk11Features.storageBuffer16BitAccess != VK_TRUE) ||
+        (physicalDevice->m_vk12Features.storageBuffer8BitAccess != VK_TRUE) ||
+        (physicalDevice->m_features.shaderInt16 != VK_TRUE) ||
+        (physicalDevice->m_vk12Features.shaderInt8 != VK_TRUE))
+    {
+        std::printf("8/16-bit storage buffers are not supported: skipped.\n");
+        return SkipReturnCode;
+    }
+
+    rad::Ref<TensorIndexing> indexing = RAD_NEW TensorIndexing(context);
+    bool passed = true;
+    passed &= TestScatterAdd<int8_t>(context.get(), indexing.get(), Tensor::DataType::Sint8, "ScatterAdd.Sint8");
+    passed &= TestScatterAdd<int16_t>(context.get(), indexing.get(), Tensor::DataType::Sint16, "ScatterAdd.Sint16");
+    return passed ? 0 : 1;
+}
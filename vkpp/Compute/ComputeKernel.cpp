@@ -0,0 +1,374 @@
+#include <vkpp/Compute/ComputeKernel.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+ComputeKernel::ComputeKernel(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+ComputeKernel::~ComputeKernel()
+{
+}
+
+bool ComputeKernel::Init(std::string_view shaderFile, rad::Span<ShaderMacro> macros,
+    uint32_t bufferCount, uint32_t pushConstantSize, uint32_t localSize)
+{
+    Device* device = m_context->GetDevice();
+    m_deviceAddressArguments = m_deviceAddressRequested && device->IsBufferDeviceAddressSupported();
+    if (m_deviceAddressArguments)
+    {
+        // No descriptor at all: the shader reads the addresses from the push constants.
+        bufferCount = 0;
+    }
+    m_bufferCount = bufferCount;
+    m_pushConstantSize = pushConstantSize;
+    m_localSize = localSize;
+
+    std::vector<VkDescriptorSetLayoutBinding> bindings(bufferCount);
+    for (uint32_t i = 0; i < bufferCount; ++i)
+    {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].pImmutableSamplers = nullptr;
+    }
+    m_pushDescriptors = m_pushDescriptorRequested && (bufferCount > 0) && device->IsPushDescriptorSupported();
+    m_descSetLayout = device->CreateDescriptorSetLayout(bindings,
+        m_pushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0);
+
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = pushConstantSize;
+    m_pipelineLayout = device->CreatePipelineLayout(m_descSetLayout.get(),
+        (pushConstantSize > 0) ? rad::Span<VkPushConstantRange>(pushConstantRange) :
+        rad::Span<VkPushConstantRange>());
+
+    if (bufferCount > 0)
+    {
+        // Descriptors are updated (or pushed) from the array of VkDescriptorBufferInfo, one binding after another.
+        std::vector<VkDescriptorUpdateTemplateEntry> entries(bufferCount);
+        for (uint32_t i = 0; i < bufferCount; ++i)
+        {
+            entries[i].dstBinding = i;
+            entries[i].dstArrayElement = 0;
+            entries[i].descriptorCount = 1;
+            entries[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            entries[i].offset = i * sizeof(VkDescriptorBufferInfo);
+            entries[i].stride = sizeof(VkDescriptorBufferInfo);
+        }
+        m_updateTemplate = m_pushDescriptors ?
+            device->CreatePushDescriptorUpdateTemplate(VK_PIPELINE_BIND_POINT_COMPUTE,
+                m_pipelineLayout.get(), 0, entries) :
+            device->CreateDescriptorUpdateTemplate(m_descSetLayout.get(), entries);
+    }
+
+    ShaderCompiler shaderCompiler;
+    shaderCompiler.SetTargetVulkanVersion(std::min<uint32_t>(
+        device->GetPhysicalDevice()->m_properties.apiVersion, VK_API_VERSION_1_3));
+    // Kernels can use native 16-bit float and 8-bit integer arithmetic if supported.
+    const PhysicalDevice* physicalDevice = device->GetPhysicalDevice();
+    std::vector<ShaderMacro> kernelMacros(macros.begin(), macros.end());
+    kernelMacros.emplace_back("SHADER_FLOAT16",
+        (physicalDevice->m_vk12Features.shaderFloat16 == VK_TRUE) ? 1u : 0u);
+    kernelMacros.emplace_back("SHADER_INT8",
+        (physicalDevice->m_vk12Features.shaderInt8 == VK_TRUE) ? 1u : 0u);
+    kernelMacros.emplace_back("DEVICE_ADDRESS", m_deviceAddressArguments ? 1u : 0u);
+    std::vector<uint32_t> binary = shaderCompiler.CompileGLSLFromFile(
+        VK_SHADER_STAGE_COMPUTE_BIT, std::string(shaderFile), "main", kernelMacros);
+    if (binary.empty())
+    {
+        VKPP_LOG(err, "ComputeKernel: failed to compile {}", shaderFile);
+        return false;
+    }
+
+    ComputePipelineCreateInfo pipelineInfo(device);
+    pipelineInfo.m_shaderModule = device->CreateShaderModule(binary);
+    pipelineInfo.m_shaderSpecialization = RAD_NEW SpecializationInfo();
+    pipelineInfo.m_shaderSpecialization->Add(0, m_localSize);
+    for (size_t i = 0; i < m_specConstants.size(); ++i)
+    {
+        pipelineInfo.m_shaderSpecialization->Add(static_cast<uint32_t>(i + 1), m_specConstants[i]);
+    }
+    pipelineInfo.m_layout = m_pipelineLayout;
+    const VkPhysicalDeviceVulkan13Properties& vk13Properties = physicalDevice->m_vk13Properties;
+    // Fixed on some devices.
+    m_subgroupSize = ((vk13Properties.minSubgroupSize > 0) &&
+        (vk13Properties.minSubgroupSize == vk13Properties.maxSubgroupSize)) ?
+        vk13Properties.minSubgroupSize : 0;
+    if (m_subgroupSizeRequested && physicalDevice->m_vk13Features.subgroupSizeControl &&
+        rad::HasBits<uint32_t>(vk13Properties.requiredSubgroupSizeStages, VK_SHADER_STAGE_COMPUTE_BIT))
+    {
+        uint32_t subgroupSize = (m_requestedSubgroupSize > 0) ?
+            m_requestedSubgroupSize : GetPreferredSubgroupSize(physicalDevice);
+        subgroupSize = std::clamp(subgroupSize,
+            vk13Properties.minSubgroupSize, vk13Properties.maxSubgroupSize);
+        // A workgroup can have at most maxComputeWorkgroupSubgroups subgroups.
+        if (m_localSize <= subgroupSize * vk13Properties.maxComputeWorkgroupSubgroups)
+        {
+            pipelineInfo.m_requiredSubgroupSize = subgroupSize;
+            m_subgroupSize = subgroupSize;
+        }
+    }
+    if (m_subgroupSizeRequested && m_requireFullSubgroups)
+    {
+        uint32_t maxSubgroupSize = (m_subgroupSize > 0) ? m_subgroupSize :
+            std::max(vk13Properties.maxSubgroupSize, physicalDevice->m_vk11Properties.subgroupSize);
+        pipelineInfo.m_requireFullSubgroups = (maxSubgroupSize > 0) && (m_localSize % maxSubgroupSize == 0);
+    }
+    m_pipeline = device->CreateComputePipeline(pipelineInfo.Setup());
+
+    if ((bufferCount > 0) && !m_pushDescriptors)
+    {
+        // Sets are released when the op completes; more pools are chained if many are in flight.
+        m_descAllocator = RAD_NEW DescriptorAllocator(device,
+            {
+                VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferCount },
+            },
+            1, MaxDescriptorSets, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
+    }
+    return true;
+}
+
+void ComputeKernel::SetDeviceAddressArguments()
+{
+    assert(!m_pipeline);
+    m_deviceAddressRequested = true;
+}
+
+void ComputeKernel::SetPushDescriptorArguments()
+{
+    assert(!m_pipeline);
+    m_pushDescriptorRequested = true;
+}
+
+void ComputeKernel::SetSpecializationConstants(rad::Span<uint32_t> values)
+{
+    assert(!m_pipeline);
+    m_specConstants.assign(values.begin(), values.end());
+}
+
+void ComputeKernel::SetRequiredSubgroupSize(uint32_t subgroupSize, bool fullSubgroups)
+{
+    assert(!m_pipeline);
+    m_subgroupSizeRequested = true;
+    m_requestedSubgroupSize = subgroupSize;
+    m_requireFullSubgroups = fullSubgroups;
+}
+
+uint32_t ComputeKernel::GetMinSubgroupSize() const
+{
+    if (m_subgroupSize > 0)
+    {
+        return m_subgroupSize;
+    }
+    const PhysicalDevice* physicalDevice = m_context->GetDevice()->GetPhysicalDevice();
+    uint32_t minSubgroupSize = physicalDevice->m_vk11Properties.subgroupSize;
+    if (physicalDevice->m_vk13Properties.minSubgroupSize > 0)
+    {
+        minSubgroupSize = std::min(minSubgroupSize, physicalDevice->m_vk13Properties.minSubgroupSize);
+    }
+    return minSubgroupSize;
+}
+
+uint32_t ComputeKernel::GetPreferredSubgroupSize(const PhysicalDevice* physicalDevice)
+{
+    const VkPhysicalDeviceVulkan13Properties& vk13Properties = physicalDevice->m_vk13Properties;
+    if (vk13Properties.maxSubgroupSize == 0)
+    {
+        return physicalDevice->m_vk11Properties.subgroupSize;
+    }
+    // Intel
+    if (physicalDevice->m_properties.vendorID == 0x8086)
+    {
+        return std::clamp(16u, vk13Properties.minSubgroupSize, vk13Properties.maxSubgroupSize);
+    }
+    return vk13Properties.maxSubgroupSize;
+}
+
+void ComputeKernel::AddDataTypeMacros(std::vector<ShaderMacro>& macros,
+    std::string_view name, Tensor::DataType dataType)
+{
+    macros.emplace_back(name, std::string_view(GetShaderTypeName(dataType)));
+    macros.emplace_back(std::string(name) + "_ID", static_cast<uint32_t>(dataType));
+}
+
+const char* ComputeKernel::GetShaderTypeName(Tensor::DataType dataType)
+{
+    switch (dataType)
+    {
+    case Tensor::DataType::Float16: return "float16_t";
+    case Tensor::DataType::Float32: return "float";
+    case Tensor::DataType::Float64: return "double";
+    case Tensor::DataType::Sint8:   return "int8_t";
+    case Tensor::DataType::Sint16:  return "int16_t";
+    case Tensor::DataType::Sint32:  return "int";
+    case Tensor::DataType::Sint64:  return "int64_t";
+    case Tensor::DataType::Uint8:   return "uint8_t";
+    case Tensor::DataType::Uint16:  return "uint16_t";
+    case Tensor::DataType::Uint32:  return "uint";
+    case Tensor::DataType::Uint64:  return "uint64_t";
+    // Converted by LOAD_DATA_TYPE/STORE_DATA_TYPE (Tensor.glsl).
+    case Tensor::DataType::BFloat16: return "uint16_t";
+    }
+    return "";
+}
+
+bool ComputeKernel::GetTensorShape(const Tensor* tensor,
+    uint32_t sizes[MaxDimensions], uint32_t strides[MaxDimensions])
+{
+    size_t numDimensions = tensor->m_sizes.size();
+    if ((numDimensions == 0) || (numDimensions > MaxDimensions) ||
+        (tensor->GetElementCount() > UINT32_MAX) ||
+        (tensor->m_bufferSize / Tensor::GetElementSizeInBytes(tensor->m_dataType) > UINT32_MAX))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < MaxDimensions; ++i)
+    {
+        sizes[i] = (i < numDimensions) ? static_cast<uint32_t>(tensor->m_sizes[i]) : 1;
+        strides[i] = (i < numDimensions) ? static_cast<uint32_t>(tensor->m_strides[i]) : 0;
+    }
+    return true;
+}
+
+bool ComputeKernel::IsChannelLast(const Tensor* tensor)
+{
+    if ((tensor->m_memLayout == Tensor::MemoryLayout::NHWC) ||
+        (tensor->m_memLayout == Tensor::MemoryLayout::NDHWC))
+    {
+        return true;
+    }
+    if ((tensor->m_memLayout == Tensor::MemoryLayout::NCHW) ||
+        (tensor->m_memLayout == Tensor::MemoryLayout::NCDHW))
+    {
+        return false;
+    }
+    // The layout is ambiguous if some dimensions are 1, prefer channel first.
+    uint32_t shape[5] = {};
+    return !GetSpatialShape(tensor, false, shape) && GetSpatialShape(tensor, true, shape);
+}
+
+bool ComputeKernel::GetSpatialShape(const Tensor* tensor, bool channelLast, uint32_t shape[5])
+{
+    const size_t numDimensions = tensor->m_sizes.size();
+    if (((numDimensions != 4) && (numDimensions != 5)) ||
+        (tensor->GetElementCount() > UINT32_MAX))
+    {
+        return false;
+    }
+
+    // Logical order: N, C, D, H, W.
+    uint64_t sizes[5] = {};
+    uint64_t strides[5] = {};
+    if (numDimensions == 4)
+    {
+        const uint32_t dims[5] = { 0, 1, UINT32_MAX, 2, 3 };
+        for (int i = 0; i < 5; ++i)
+        {
+            sizes[i] = (dims[i] != UINT32_MAX) ? tensor->m_sizes[dims[i]] : 1;
+            strides[i] = (dims[i] != UINT32_MAX) ? tensor->m_strides[dims[i]] : 0;
+        }
+    }
+    else
+    {
+        std::copy_n(tensor->m_sizes.begin(), 5, sizes);
+        std::copy_n(tensor->m_strides.begin(), 5, strides);
+    }
+
+    // Memory order from the innermost dimension.
+    const int channelFirstOrder[5] = { 4, 3, 2, 1, 0 };
+    const int channelLastOrder[5] = { 1, 4, 3, 2, 0 };
+    const int* order = channelLast ? channelLastOrder : channelFirstOrder;
+    uint64_t expectedStride = 1;
+    for (int i = 0; i < 5; ++i)
+    {
+        int dim = order[i];
+        if ((sizes[dim] > 1) && (strides[dim] != expectedStride))
+        {
+            return false;
+        }
+        expectedStride *= sizes[dim];
+    }
+
+    for (int i = 0; i < 5; ++i)
+    {
+        shape[i] = static_cast<uint32_t>(sizes[i]);
+    }
+    return true;
+}
+
+uint32_t ComputeKernel::GetGroupCount(uint64_t elementCount) const
+{
+    uint64_t groupCount = (elementCount + m_localSize - 1) / m_localSize;
+    uint64_t maxGroupCount = m_context->GetDevice()->GetLimits().maxComputeWorkGroupCount[0];
+    return static_cast<uint32_t>(std::clamp<uint64_t>(groupCount, 1, maxGroupCount));
+}
+
+rad::Ref<DescriptorSet> ComputeKernel::AllocateDescriptorSet(
+    rad::Span<VkDescriptorBufferInfo> bufferInfos)
+{
+    assert(bufferInfos.size() == m_bufferCount);
+    assert(!m_pushDescriptors);
+    rad::Ref<DescriptorSet> descSet = m_descAllocator->Allocate(m_descSetLayout.get());
+    if (!descSet)
+    {
+        return nullptr;
+    }
+    descSet->Update(m_updateTemplate.get(), bufferInfos.data());
+    return descSet;
+}
+
+bool ComputeKernel::Dispatch(CommandBuffer* cmdBuffer, DescriptorSet* descSet,
+    const void* pushConstants, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    // The shader would access unbound descriptors.
+    if (!descSet && !m_deviceAddressArguments && !m_pushDescriptors && (m_bufferCount > 0))
+    {
+        VKPP_LOG(err, "ComputeKernel: no descriptor set to dispatch (allocation failed)!");
+        return false;
+    }
+    cmdBuffer->BindPipeline(m_pipeline.get());
+    if (descSet)
+    {
+        cmdBuffer->BindDescriptorSets(m_pipeline.get(), m_pipelineLayout.get(), 0, descSet);
+    }
+    if (m_pushConstantSize > 0)
+    {
+        cmdBuffer->SetPushConstants(m_pipelineLayout.get(), VK_SHADER_STAGE_COMPUTE_BIT,
+            0, m_pushConstantSize, pushConstants);
+    }
+    cmdBuffer->Dispatch(groupCountX, groupCountY, groupCountZ);
+    return true;
+}
+
+bool ComputeKernel::DispatchWithBuffers(CommandBuffer* cmdBuffer,
+    rad::Span<VkDescriptorBufferInfo> bufferInfos, const void* pushConstants, rad::Ref<DescriptorSet>& descSet,
+    uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    if (!m_pushDescriptors)
+    {
+        descSet = AllocateDescriptorSet(bufferInfos);
+        return Dispatch(cmdBuffer, descSet.get(), pushConstants, groupCountX, groupCountY, groupCountZ);
+    }
+
+    assert(bufferInfos.size() == m_bufferCount);
+    cmdBuffer->BindPipeline(m_pipeline.get());
+    cmdBuffer->PushDescriptorSetWithTemplate(m_updateTemplate.get(), m_pipelineLayout.get(), 0,
+        bufferInfos.data());
+    if (m_pushConstantSize > 0)
+    {
+        cmdBuffer->SetPushConstants(m_pipelineLayout.get(), VK_SHADER_STAGE_COMPUTE_BIT,
+            0, m_pushConstantSize, pushConstants);
+    }
+    cmdBuffer->Dispatch(groupCountX, groupCountY, groupCountZ);
+    descSet = nullptr;
+    return true;
+}
+
+} // namespace vkpp
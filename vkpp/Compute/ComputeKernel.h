@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vkpp/Compute/Tensor.h>
+#include <vkpp/Core/ShaderCompiler.h>
+
+namespace vkpp
+{
+
+// A compute pipeline operating on storage buffers (set = 0, binding = [0, bufferCount)),
+// with parameters passed by push constants.
+// The workgroup size is a specialization constant (local_size_x_id = 0),
+// other tunable parameters can use constant_id 1, 2, ... (see SetSpecializationConstants).
+class ComputeKernel : public rad::RefCounted<ComputeKernel>
+{
+public:
+    static constexpr uint32_t MaxDescriptorSets = 64;
+    // Max number of dimensions of tensors passed to kernels (TENSOR_MAX_DIMS in Tensor.glsl).
+    static constexpr uint32_t MaxDimensions = 8;
+
+    ComputeKernel(rad::Ref<Context> context);
+    virtual ~ComputeKernel();
+    VKPP_DISABLE_COPY_AND_MOVE(ComputeKernel);
+
+    // @param shaderFile: relative to g_shaderPath.
+    bool Init(std::string_view shaderFile, rad::Span<ShaderMacro> macros,
+        uint32_t bufferCount, uint32_t pushConstantSize, uint32_t localSize = 256);
+
+    // Add macros <name> (GLSL type) and <name>_ID (the value of Tensor::DataType, see Tensor.glsl).
+    static void AddDataTypeMacros(std::vector<ShaderMacro>& macros,
+        std::string_view name, Tensor::DataType dataType);
+    static const char* GetShaderTypeName(Tensor::DataType dataType);
+
+    // Fill the sizes and strides (in elements) of the tensor for push constants;
+    // return false if the tensor has too many dimensions or cannot be indexed with 32-bit.
+    static bool GetTensorShape(const Tensor* tensor,
+        uint32_t sizes[MaxDimensions], uint32_t strides[MaxDimensions]);
+    // Whether a 4D/5D tensor is stored in the channel last layout (NHWC/NDHWC).
+    static bool IsChannelLast(const Tensor* tensor);
+    // Fill the sizes (N, C, D, H, W) of a 4D (D = 1) or 5D tensor stored contiguously
+    // in channel first (NCHW/NCDHW) or channel last (NHWC/NDHWC) layout;
+    // dimensions of size 1 can have any stride. Return false if the tensor is not in the layout.
+    static bool GetSpatialShape(const Tensor* tensor, bool channelLast, uint32_t shape[5]);
+
+    // Take the buffers by device address in the push constants instead of descriptors (before Init),
+    // if the device supports bufferDeviceAddress: no descriptor set is allocated, updated or bound
+    // (see DEVICE_ADDRESS in Tensor.glsl). Check UsesDeviceAddresses() after Init.
+    void SetDeviceAddressArguments();
+    bool UsesDeviceAddresses() const { return m_deviceAddressArguments; }
+
+    // Push the buffers into the command buffer (VK_KHR_push_descriptor) instead of allocating
+    // and updating a descriptor set per dispatch (before Init); use DispatchWithBuffers.
+    void SetPushDescriptorArguments();
+    bool UsesPushDescriptors() const { return m_pushDescriptors; }
+
+    // Values of the specialization constants constant_id = 1, 2, ... (before Init).
+    void SetSpecializationConstants(rad::Span<uint32_t> values);
+
+    // Request the subgroup size of a kernel using subgroup operations (before Init);
+    // 0 selects GetPreferredSubgroupSize(). Ignored if subgroupSizeControl is not supported.
+    // @param fullSubgroups: require full subgroups if the local size is a multiple of the subgroup size.
+    void SetRequiredSubgroupSize(uint32_t subgroupSize = 0, bool fullSubgroups = true);
+    // The subgroup size the pipeline runs with if it is known, otherwise 0.
+    uint32_t GetSubgroupSize() const { return m_subgroupSize; }
+    // The smallest subgroup size the pipeline may run with.
+    uint32_t GetMinSubgroupSize() const;
+    // For reductions and scans: the largest size supported, which takes the fewest steps across subgroups;
+    // 16 on Intel, where SIMD32 doubles the register pressure.
+    static uint32_t GetPreferredSubgroupSize(const PhysicalDevice* physicalDevice);
+
+    uint32_t GetLocalSize() const { return m_localSize; }
+    // Group count for a grid-stride loop over elementCount elements.
+    uint32_t GetGroupCount(uint64_t elementCount) const;
+
+    // Return nullptr if the allocation fails.
+    rad::Ref<DescriptorSet> AllocateDescriptorSet(rad::Span<VkDescriptorBufferInfo> bufferInfos);
+    // Return false, and record nothing, if descSet is null while the kernel takes its buffers
+    // by a descriptor set (not UsesDeviceAddresses): the caller must not submit the commands.
+    bool Dispatch(CommandBuffer* cmdBuffer, DescriptorSet* descSet, const void* pushConstants,
+        uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+    // Bind the buffers by push descriptors if UsesPushDescriptors(), otherwise by a descriptor set allocated
+    // into descSet, which must be kept alive until the commands complete; return false as Dispatch.
+    bool DispatchWithBuffers(CommandBuffer* cmdBuffer,
+        rad::Span<VkDescriptorBufferInfo> bufferInfos, const void* pushConstants, rad::Ref<DescriptorSet>& descSet,
+        uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+
+    rad::Ref<Context> m_context;
+    uint32_t m_bufferCount = 0;
+    uint32_t m_pushConstantSize = 0;
+    uint32_t m_localSize = 256;
+    std::vector<uint32_t> m_specConstants;
+    bool m_deviceAddressRequested = false;
+    bool m_deviceAddressArguments = false;
+    bool m_pushDescriptorRequested = false;
+    bool m_pushDescriptors = false;
+    bool m_subgroupSizeRequested = false;
+    uint32_t m_requestedSubgroupSize = 0;
+    bool m_requireFullSubgroups = false;
+    uint32_t m_subgroupSize = 0;
+
+    rad::Ref<DescriptorSetLayout> m_descSetLayout;
+    rad::Ref<DescriptorUpdateTemplate> m_updateTemplate;
+    rad::Ref<PipelineLayout> m_pipelineLayout;
+    rad::Ref<Pipeline> m_pipeline;
+    rad::Ref<DescriptorAllocator> m_descAllocator;
+
+}; // class ComputeKernel
+
+} // namespace vkpp
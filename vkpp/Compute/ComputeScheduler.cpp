@@ -0,0 +1,178 @@
+#include <vkpp/Compute/ComputeScheduler.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace vkpp
+{
+
+ComputeScheduler::ComputeScheduler(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+ComputeScheduler::~ComputeScheduler()
+{
+    WaitIdle();
+}
+
+bool ComputeScheduler::Init()
+{
+    Device* device = m_context->GetDevice();
+    if (!device->IsTimelineSemaphoreSupported())
+    {
+        VKPP_LOG(err, "ComputeScheduler: timeline semaphores are not supported!");
+        return false;
+    }
+
+    m_queueFamily = (m_context->GetQueueCount(QueueFamilyCompute) > 0) ?
+        QueueFamilyCompute : QueueFamilyUniversal;
+    const uint32_t queueCount = m_context->GetQueueCount(m_queueFamily);
+    m_queues.clear();
+    for (uint32_t queueIndex = 0; queueIndex < queueCount; ++queueIndex)
+    {
+        auto state = std::make_unique<QueueState>();
+        state->queue = m_context->GetQueue(m_queueFamily, queueIndex);
+        state->timeline = device->CreateTimelineSemaphore(0);
+        state->cmdPool = device->CreateCommandPool(m_queueFamily, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        m_queues.push_back(std::move(state));
+    }
+    VKPP_LOG(info, "ComputeScheduler: {} queue(s) of the queue family #{}",
+        queueCount, device->GetQueueFamilyIndex(m_queueFamily));
+    return !m_queues.empty();
+}
+
+ComputeScheduler::SyncPoint ComputeScheduler::Submit(
+    const RecordCallback& record, rad::Span<SyncPoint> dependencies)
+{
+    return Submit(SelectQueue(), record, dependencies);
+}
+
+ComputeScheduler::SyncPoint ComputeScheduler::Submit(
+    uint32_t queueIndex, const RecordCallback& record, rad::Span<SyncPoint> dependencies)
+{
+    if (queueIndex >= m_queues.size())
+    {
+        VKPP_LOG(err, "ComputeScheduler::Submit: queue index {} is out of range (queueCount={})!",
+            queueIndex, m_queues.size());
+        return {};
+    }
+
+    // Wait for the latest value of each queue depended on; the dependencies on the same queue
+    // are also waited, since submissions to a queue can overlap.
+    std::vector<uint64_t> waitValues(m_queues.size(), 0);
+    for (const SyncPoint& dependency : dependencies)
+    {
+        if ((dependency.queueIndex < m_queues.size()) && (dependency.value > 0))
+        {
+            waitValues[dependency.queueIndex] =
+                std::max(waitValues[dependency.queueIndex], dependency.value);
+        }
+    }
+    std::vector<TimelineWaitInfo> waits;
+    for (uint32_t i = 0; i < waitValues.size(); ++i)
+    {
+        if (waitValues[i] > 0)
+        {
+            waits.push_back({ m_queues[i]->timeline.get(), waitValues[i],
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT });
+        }
+    }
+
+    QueueState& state = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(state.mutex);
+    Collect(state);
+
+    rad::Ref<CommandBuffer> cmdBuffer = state.cmdPool->Allocate();
+    cmdBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    record(cmdBuffer.get());
+    cmdBuffer->End();
+
+    // Signal values must increase in submission order: assigned and submitted with the mutex locked.
+    const uint64_t value = state.submittedValue + 1;
+    TimelineSignalInfo signal = { state.timeline.get(), value };
+    state.queue->Submit(cmdBuffer.get(), waits, signal);
+    state.submittedValue = value;
+    state.submissions.push_back({ value, std::move(cmdBuffer) });
+
+    SyncPoint syncPoint;
+    syncPoint.queueIndex = queueIndex;
+    syncPoint.value = value;
+    return syncPoint;
+}
+
+bool ComputeScheduler::IsComplete(const SyncPoint& syncPoint)
+{
+    if ((syncPoint.queueIndex >= m_queues.size()) || (syncPoint.value == 0))
+    {
+        return true;
+    }
+    return (m_queues[syncPoint.queueIndex]->timeline->GetCounterValue() >= syncPoint.value);
+}
+
+bool ComputeScheduler::Wait(const SyncPoint& syncPoint, uint64_t timeout)
+{
+    if ((syncPoint.queueIndex >= m_queues.size()) || (syncPoint.value == 0))
+    {
+        return true;
+    }
+    return (m_queues[syncPoint.queueIndex]->timeline->Wait(syncPoint.value, timeout) == VK_SUCCESS);
+}
+
+void ComputeScheduler::WaitIdle()
+{
+    for (std::unique_ptr<QueueState>& state : m_queues)
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->submittedValue > 0)
+        {
+            state->timeline->Wait(state->submittedValue);
+        }
+        Collect(*state);
+    }
+}
+
+uint32_t ComputeScheduler::SelectQueue()
+{
+    const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+    if (queueCount <= 1)
+    {
+        return 0;
+    }
+    const uint32_t start = m_nextQueueIndex.fetch_add(1) % queueCount;
+    uint32_t bestIndex = start;
+    uint64_t bestPending = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < queueCount; ++i)
+    {
+        const uint32_t queueIndex = (start + i) % queueCount;
+        QueueState& state = *m_queues[queueIndex];
+        const uint64_t submittedValue = state.submittedValue;
+        const uint64_t completedValue = state.timeline->GetCounterValue();
+        const uint64_t pending = (submittedValue > completedValue) ? (submittedValue - completedValue) : 0;
+        if (pending < bestPending)
+        {
+            bestPending = pending;
+            bestIndex = queueIndex;
+            if (pending == 0)
+            {
+                break;
+            }
+        }
+    }
+    return bestIndex;
+}
+
+void ComputeScheduler::Collect(QueueState& state)
+{
+    if (state.submissions.empty())
+    {
+        return;
+    }
+    const uint64_t completedValue = state.timeline->GetCounterValue();
+    while (!state.submissions.empty() && (state.submissions.front().value <= completedValue))
+    {
+        state.submissions.pop_front();
+    }
+}
+
+} // namespace vkpp
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vkpp/Core/Context.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace vkpp
+{
+
+// Distribute independent compute graphs across all queues of the compute family (async compute queues),
+// so that concurrent streams of work do not serialize on one queue.
+// Each queue has a timeline semaphore counting its submissions: a submission completes when the timeline
+// of its queue reaches its value (SyncPoint), and later submissions can wait for it on the device.
+// Thread-safe: submissions to different queues are recorded in parallel.
+class ComputeScheduler : public rad::RefCounted<ComputeScheduler>
+{
+public:
+    struct SyncPoint
+    {
+        uint32_t queueIndex = 0;
+        // 0 if nothing has been submitted.
+        uint64_t value = 0;
+    };
+
+    // Record the commands of a graph (between Begin and End, which the scheduler calls);
+    // resources used must be kept alive until the graph completes.
+    using RecordCallback = std::function<void(CommandBuffer* cmdBuffer)>;
+
+    ComputeScheduler(rad::Ref<Context> context);
+    ~ComputeScheduler();
+    VKPP_DISABLE_COPY_AND_MOVE(ComputeScheduler);
+
+    // Use the queues of QueueFamilyCompute, or QueueFamilyUniversal if there is no dedicated compute family;
+    // return false if the device does not support timeline semaphores.
+    bool Init();
+
+    QueueFamily GetQueueFamily() const { return m_queueFamily; }
+    uint32_t GetQueueCount() const { return static_cast<uint32_t>(m_queues.size()); }
+
+    // Record and submit the graph to the queue with the least pending submissions,
+    // to execute after the dependencies complete (on any queue).
+    SyncPoint Submit(const RecordCallback& record, rad::Span<SyncPoint> dependencies = {});
+    // Submit to a specific queue, to keep the graphs of a stream on the same queue.
+    SyncPoint Submit(uint32_t queueIndex, const RecordCallback& record, rad::Span<SyncPoint> dependencies = {});
+
+    bool IsComplete(const SyncPoint& syncPoint);
+    // @param timeout: in nanoseconds; return false if the timeout expires.
+    bool Wait(const SyncPoint& syncPoint, uint64_t timeout = UINT64_MAX);
+    void WaitIdle();
+
+private:
+    struct Submission
+    {
+        uint64_t value;
+        rad::Ref<CommandBuffer> cmdBuffer;
+    };
+
+    struct QueueState
+    {
+        Queue* queue = nullptr;
+        rad::Ref<Semaphore> timeline;
+        // Host access to the pool (allocating, recording and freeing command buffers) must be synchronized.
+        std::mutex mutex;
+        rad::Ref<CommandPool> cmdPool;
+        // Value of the last submission; read without the mutex to select the queue.
+        std::atomic<uint64_t> submittedValue = 0;
+        std::deque<Submission> submissions;
+    };
+
+    uint32_t SelectQueue();
+    // Release the submissions completed; the mutex of the queue must be locked.
+    void Collect(QueueState& state);
+
+    rad::Ref<Context> m_context;
+    QueueFamily m_queueFamily = QueueFamilyCompute;
+    std::vector<std::unique_ptr<QueueState>> m_queues;
+    // Start of the search for the least loaded queue, to spread ties.
+    std::atomic<uint32_t> m_nextQueueIndex = 0;
+
+}; // class ComputeScheduler
+
+} // namespace vkpp
@@ -0,0 +1,356 @@
+#include <vkpp/Compute/Convolution.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+Convolution::Convolution(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+Convolution::~Convolution()
+{
+}
+
+std::vector<uint64_t> Convolution::GetOutputSizes(
+    rad::Span<uint64_t> inputSizes, rad::Span<uint64_t> filterSizes, const Desc& desc)
+{
+    assert((inputSizes.size() == 4) || (inputSizes.size() == 5));
+    assert(inputSizes.size() == filterSizes.size());
+    std::vector<uint64_t> outputSizes = { inputSizes[0], filterSizes[0] };
+    const size_t spatialDims = inputSizes.size() - 2;
+    for (size_t i = 0; i < spatialDims; ++i)
+    {
+        // Skip D of 2D convolution.
+        const size_t axis = 3 - spatialDims + i;
+        uint64_t paddedSize = inputSizes[2 + i] + 2 * uint64_t(desc.padding[axis]);
+        uint64_t filterExtent = uint64_t(desc.dilations[axis]) * (filterSizes[2 + i] - 1) + 1;
+        outputSizes.push_back((paddedSize >= filterExtent) ?
+            (paddedSize - filterExtent) / desc.strides[axis] + 1 : 0);
+    }
+    return outputSizes;
+}
+
+Convolution::Algorithm Convolution::SelectAlgorithm(
+    rad::Span<uint64_t> inputSizes, rad::Span<uint64_t> filterSizes, const Desc& desc)
+{
+    // Invalid, rejected by Run.
+    if ((desc.groups == 0) || (filterSizes[0] == 0))
+    {
+        return Algorithm::Direct;
+    }
+    if ((filterSizes[1] == 1) && (desc.groups == inputSizes[1]))
+    {
+        return Algorithm::Depthwise;
+    }
+    // Reduction length of each output; the direct kernel is faster for short reductions
+    // and few output channels, where GEMM tiles would be mostly empty.
+    uint64_t reductionSize = Tensor::GetElementCount(filterSizes) / filterSizes[0];
+    uint64_t channelsPerGroup = filterSizes[0] / desc.groups;
+    if ((reductionSize >= 64) && (channelsPerGroup >= 16))
+    {
+        return Algorithm::ImplicitGemm;
+    }
+    return Algorithm::Direct;
+}
+
+std::string Convolution::GetKernelName(Tensor::DataType dataType, Algorithm algorithm, bool channelLast)
+{
+    static constexpr const char* AlgorithmNames[] = { "Direct", "ImplicitGemm", "Depthwise" };
+    return std::string("Convolution.") + AlgorithmNames[static_cast<uint32_t>(algorithm)] +
+        (channelLast ? ".ChannelLast" : ".ChannelFirst") +
+        ".DataType" + std::to_string(static_cast<uint32_t>(dataType));
+}
+
+std::string Convolution::GetShapeBucket(const PushConstants& pushConstants)
+{
+    // The GEMM sizes: M (outputs per channel), N (output channels per group) and the reduction length.
+    const uint64_t sizes[3] =
+    {
+        uint64_t(pushConstants.N) * pushConstants.OD * pushConstants.OH * pushConstants.OW,
+        pushConstants.K / pushConstants.groups,
+        uint64_t(pushConstants.C / pushConstants.groups) * pushConstants.KD * pushConstants.KH * pushConstants.KW,
+    };
+    return KernelTuner::GetShapeBucket(sizes);
+}
+
+KernelTuner::Config Convolution::GetDefaultConfig(Algorithm algorithm)
+{
+    if (algorithm == Algorithm::ImplicitGemm)
+    {
+        // The tiling requires 256 invocations; TILE_K.
+        return { 256, 16 };
+    }
+    return { 256 };
+}
+
+std::vector<KernelTuner::Config> Convolution::GetCandidateConfigs(Tensor::DataType dataType, Algorithm algorithm)
+{
+    if (algorithm != Algorithm::ImplicitGemm)
+    {
+        return m_tuner->GetLocalSizeCandidates(GetDefaultConfig(algorithm));
+    }
+    // The input and filter slices of TILE_K x 64 accumulators in shared memory;
+    // the local size is fixed by the tiling.
+    const VkDeviceSize accSize = (Tensor::GetElementSizeInBytes(dataType) == 8) ? 8 : 4;
+    const uint32_t maxSharedMemorySize = m_context->GetDevice()->GetLimits().maxComputeSharedMemorySize;
+    std::vector<KernelTuner::Config> candidates;
+    for (uint32_t tileK : { 8u, 16u, 32u })
+    {
+        if (tileK * (GemmTileM + GemmTileN) * accSize <= maxSharedMemorySize)
+        {
+            candidates.push_back({ 256, tileK });
+        }
+    }
+    return candidates;
+}
+
+KernelTuner::Config Convolution::GetConfig(Tensor::DataType dataType, Algorithm algorithm, bool channelLast,
+    const PushConstants& pushConstants)
+{
+    if (m_tuner)
+    {
+        const KernelTuner::Config* config = m_tuner->Find(
+            GetKernelName(dataType, algorithm, channelLast), GetShapeBucket(pushConstants));
+        KernelTuner::Config defaultConfig = GetDefaultConfig(algorithm);
+        // Ignore the entries of an older version of the kernel.
+        if (config && (config->size() == defaultConfig.size()) &&
+            ((algorithm != Algorithm::ImplicitGemm) || ((*config)[0] == defaultConfig[0])))
+        {
+            return *config;
+        }
+    }
+    return GetDefaultConfig(algorithm);
+}
+
+rad::Ref<ComputeKernel> Convolution::CreateKernel(Tensor::DataType dataType, Algorithm algorithm,
+    bool channelLast, const KernelTuner::Config& config)
+{
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    macros.emplace_back("CHANNEL_LAST", channelLast ? 1u : 0u);
+    const char* shaderFile = "Compute/Convolution.comp";
+    if (algorithm == Algorithm::ImplicitGemm)
+    {
+        shaderFile = "Compute/ConvolutionImplicitGemm.comp";
+    }
+    else
+    {
+        macros.emplace_back("DEPTHWISE", (algorithm == Algorithm::Depthwise) ? 1u : 0u);
+    }
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetSpecializationConstants(rad::Span<uint32_t>(config.data() + 1, config.size() - 1));
+    kernel->SetPushDescriptorArguments();
+    if (!kernel->Init(shaderFile, macros, 4, sizeof(PushConstants), config[0]))
+    {
+        return nullptr;
+    }
+    return kernel;
+}
+
+ComputeKernel* Convolution::GetKernel(Tensor::DataType dataType, Algorithm algorithm, bool channelLast,
+    const KernelTuner::Config& config)
+{
+    auto key = std::make_tuple(dataType, algorithm, channelLast, config);
+    auto iter = m_kernels.find(key);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    rad::Ref<ComputeKernel> kernel = CreateKernel(dataType, algorithm, channelLast, config);
+    if (!kernel)
+    {
+        return nullptr;
+    }
+    m_kernels[key] = kernel;
+    return kernel.get();
+}
+
+bool Convolution::Run(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const Desc& desc)
+{
+    return Run(input, filter, bias, output, desc, SelectAlgorithm(input->m_sizes, filter->m_sizes, desc));
+}
+
+bool Convolution::Run(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const Desc& desc,
+    Algorithm algorithm)
+{
+    PushConstants pushConstants = {};
+    bool channelLast = false;
+    if (!SetupPushConstants(input, filter, bias, output, desc, algorithm, pushConstants, channelLast))
+    {
+        return false;
+    }
+    if (pushConstants.outputCount == 0)
+    {
+        return true;
+    }
+
+    const Tensor::DataType dataType = input->m_dataType;
+    ComputeKernel* kernel = GetKernel(dataType, algorithm, channelLast,
+        GetConfig(dataType, algorithm, channelLast, pushConstants));
+    if (!kernel)
+    {
+        return false;
+    }
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    rad::Ref<DescriptorSet> descSet;
+    if (!CmdRun(cmdBuffer.get(), kernel, algorithm, input, filter, bias, output, pushConstants, descSet))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+bool Convolution::Tune(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const Desc& desc,
+    Algorithm algorithm)
+{
+    if (!m_tuner)
+    {
+        VKPP_LOG(err, "Convolution: no tuner!");
+        return false;
+    }
+    PushConstants pushConstants = {};
+    bool channelLast = false;
+    if (!SetupPushConstants(input, filter, bias, output, desc, algorithm, pushConstants, channelLast) ||
+        (pushConstants.outputCount == 0))
+    {
+        return false;
+    }
+
+    const Tensor::DataType dataType = input->m_dataType;
+    std::vector<KernelTuner::Config> candidates = GetCandidateConfigs(dataType, algorithm);
+    KernelTuner::Config bestConfig = m_tuner->Tune(
+        GetKernelName(dataType, algorithm, channelLast), GetShapeBucket(pushConstants), candidates,
+        [&](const KernelTuner::Config& config)
+        {
+            return CreateKernel(dataType, algorithm, channelLast, config);
+        },
+        [&](CommandBuffer* cmdBuffer, ComputeKernel* kernel, rad::Ref<DescriptorSet>& descSet)
+        {
+            return CmdRun(cmdBuffer, kernel, algorithm, input, filter, bias, output, pushConstants, descSet);
+        });
+    return !bestConfig.empty();
+}
+
+bool Convolution::SetupPushConstants(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output,
+    const Desc& desc, Algorithm algorithm, PushConstants& pushConstants, bool& channelLast)
+{
+    const Tensor::DataType dataType = input->m_dataType;
+    if (!Tensor::IsFloatingPoint(dataType) ||
+        (filter->m_dataType != dataType) || (output->m_dataType != dataType) ||
+        (bias && (bias->m_dataType != dataType)))
+    {
+        VKPP_LOG(err, "Convolution: data types mismatch or not supported!");
+        return false;
+    }
+
+    channelLast = ComputeKernel::IsChannelLast(input);
+    uint32_t inputShape[5] = {};
+    uint32_t filterShape[5] = {};
+    uint32_t outputShape[5] = {};
+    if ((filter->GetNumDimensions() != input->GetNumDimensions()) ||
+        !ComputeKernel::GetSpatialShape(input, channelLast, inputShape) ||
+        !ComputeKernel::GetSpatialShape(filter, channelLast, filterShape) ||
+        !ComputeKernel::GetSpatialShape(output, channelLast, outputShape))
+    {
+        VKPP_LOG(err, "Convolution: tensors must be contiguous in the same layout (NCHW/NHWC/NCDHW/NDHWC)!");
+        return false;
+    }
+    // D is ignored for 4D tensors.
+    for (size_t axis = (input->GetNumDimensions() == 5) ? 0 : 1; axis < 3; ++axis)
+    {
+        if ((desc.strides[axis] == 0) || (desc.dilations[axis] == 0))
+        {
+            VKPP_LOG(err, "Convolution: strides and dilations must not be zero!");
+            return false;
+        }
+    }
+    if ((desc.groups == 0) || (inputShape[1] % desc.groups != 0) || (filterShape[0] % desc.groups != 0) ||
+        (filterShape[1] != inputShape[1] / desc.groups) ||
+        (output->m_sizes != GetOutputSizes(input->m_sizes, filter->m_sizes, desc)) ||
+        (bias && ((bias->GetNumDimensions() != 1) || (bias->m_sizes[0] != filterShape[0]) ||
+            (bias->m_strides[0] != 1))))
+    {
+        VKPP_LOG(err, "Convolution: invalid sizes!");
+        return false;
+    }
+    if ((algorithm == Algorithm::Depthwise) && (filterShape[1] != 1))
+    {
+        VKPP_LOG(err, "Convolution: depthwise requires one input channel per group!");
+        return false;
+    }
+
+    // D of 2D convolution: size 1, no padding.
+    const bool is3D = (input->GetNumDimensions() == 5);
+    pushConstants = {};
+    pushConstants.N = inputShape[0];
+    pushConstants.C = inputShape[1];
+    pushConstants.D = inputShape[2];
+    pushConstants.H = inputShape[3];
+    pushConstants.W = inputShape[4];
+    pushConstants.K = outputShape[1];
+    pushConstants.OD = outputShape[2];
+    pushConstants.OH = outputShape[3];
+    pushConstants.OW = outputShape[4];
+    pushConstants.KD = filterShape[2];
+    pushConstants.KH = filterShape[3];
+    pushConstants.KW = filterShape[4];
+    pushConstants.strideD = is3D ? desc.strides[0] : 1;
+    pushConstants.strideH = desc.strides[1];
+    pushConstants.strideW = desc.strides[2];
+    pushConstants.padD = is3D ? desc.padding[0] : 0;
+    pushConstants.padH = desc.padding[1];
+    pushConstants.padW = desc.padding[2];
+    pushConstants.dilationD = is3D ? desc.dilations[0] : 1;
+    pushConstants.dilationH = desc.dilations[1];
+    pushConstants.dilationW = desc.dilations[2];
+    pushConstants.groups = desc.groups;
+    pushConstants.outputCount = static_cast<uint32_t>(output->GetElementCount());
+    pushConstants.flags = bias ? FlagBias : 0;
+
+    return true;
+}
+
+bool Convolution::CmdRun(CommandBuffer* cmdBuffer, ComputeKernel* kernel, Algorithm algorithm,
+    Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const PushConstants& pushConstants,
+    rad::Ref<DescriptorSet>& descSet)
+{
+    // Bind the output in place of the missing bias, it is not accessed.
+    VkDescriptorBufferInfo bufferInfos[] =
+    {
+        input->GetDescriptorInfo(),
+        filter->GetDescriptorInfo(),
+        (bias ? bias : output)->GetDescriptorInfo(),
+        output->GetDescriptorInfo(),
+    };
+
+    if (algorithm == Algorithm::ImplicitGemm)
+    {
+        const VkPhysicalDeviceLimits& limits = m_context->GetDevice()->GetLimits();
+        const uint64_t gemmM = uint64_t(pushConstants.N) * pushConstants.OD * pushConstants.OH * pushConstants.OW;
+        const uint64_t gemmN = pushConstants.K / pushConstants.groups;
+        // Tiles along M are processed in a grid-stride loop.
+        uint32_t groupCountX = static_cast<uint32_t>(std::min<uint64_t>(
+            (gemmM + GemmTileM - 1) / GemmTileM, limits.maxComputeWorkGroupCount[0]));
+        uint32_t groupCountY = static_cast<uint32_t>((gemmN + GemmTileN - 1) / GemmTileN);
+        assert(groupCountY <= limits.maxComputeWorkGroupCount[1]);
+        assert(pushConstants.groups <= limits.maxComputeWorkGroupCount[2]);
+        return kernel->DispatchWithBuffers(cmdBuffer, bufferInfos, &pushConstants, descSet,
+            groupCountX, groupCountY, pushConstants.groups);
+    }
+    else
+    {
+        return kernel->DispatchWithBuffers(cmdBuffer, bufferInfos, &pushConstants, descSet,
+            kernel->GetGroupCount(pushConstants.outputCount));
+    }
+}
+
+} // namespace vkpp
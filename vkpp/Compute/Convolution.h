@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <vkpp/Compute/KernelTuner.h>
+#include <array>
+#include <map>
+#include <tuple>
+
+namespace vkpp
+{
+
+// 2D/3D convolution of floating point tensors.
+// Tensors must be contiguous in the same layout, NCHW/NHWC or NCDHW/NDHWC (Tensor::m_memLayout),
+// which selects the kernel specialized for the layout; 2D convolution runs as 3D with D = 1.
+class Convolution : public rad::RefCounted<Convolution>
+{
+public:
+    enum class Algorithm : uint32_t
+    {
+        Direct,         // small filters
+        ImplicitGemm,   // large filters, im2col on the fly
+        Depthwise,      // one input channel per group
+    };
+
+    // Spatial parameters are in (D, H, W) order; D is ignored for 4D tensors.
+    struct Desc
+    {
+        std::array<uint32_t, 3> strides = { 1, 1, 1 };
+        std::array<uint32_t, 3> padding = { 0, 0, 0 };
+        std::array<uint32_t, 3> dilations = { 1, 1, 1 };
+        uint32_t groups = 1;
+    };
+
+    Convolution(rad::Ref<Context> context);
+    ~Convolution();
+    VKPP_DISABLE_COPY_AND_MOVE(Convolution);
+
+    // Output sizes of input (N, C, [D,] H, W) and filter (K, C / groups, [KD,] KH, KW).
+    static std::vector<uint64_t> GetOutputSizes(
+        rad::Span<uint64_t> inputSizes, rad::Span<uint64_t> filterSizes, const Desc& desc);
+    static Algorithm SelectAlgorithm(
+        rad::Span<uint64_t> inputSizes, rad::Span<uint64_t> filterSizes, const Desc& desc);
+
+    // @param bias: (K), optional.
+    // @param output: (N, K, [OD,] OH, OW), see GetOutputSizes.
+    bool Run(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const Desc& desc);
+    bool Run(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const Desc& desc,
+        Algorithm algorithm);
+
+    // Kernels use the configs tuned for the shape if any; nullptr to use the defaults.
+    void SetTuner(rad::Ref<KernelTuner> tuner) { m_tuner = std::move(tuner); }
+    // Tune the kernel of the algorithm for the shape of the tensors, and record the fastest config in the tuner.
+    bool Tune(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const Desc& desc,
+        Algorithm algorithm);
+
+private:
+    // Must match Convolution.comp and ConvolutionImplicitGemm.comp.
+    struct PushConstants
+    {
+        uint32_t N, C, D, H, W;
+        uint32_t K, OD, OH, OW;
+        uint32_t KD, KH, KW;
+        uint32_t strideD, strideH, strideW;
+        uint32_t padD, padH, padW;
+        uint32_t dilationD, dilationH, dilationW;
+        uint32_t groups;
+        uint32_t outputCount;
+        uint32_t flags;
+    };
+
+    static constexpr uint32_t FlagBias = 0x1;
+    // Tile sizes of ConvolutionImplicitGemm.comp.
+    static constexpr uint32_t GemmTileM = 64;
+    static constexpr uint32_t GemmTileN = 64;
+
+    static std::string GetKernelName(Tensor::DataType dataType, Algorithm algorithm, bool channelLast);
+    static std::string GetShapeBucket(const PushConstants& pushConstants);
+    // Local size, TILE_K of ConvolutionImplicitGemm.comp.
+    static KernelTuner::Config GetDefaultConfig(Algorithm algorithm);
+    std::vector<KernelTuner::Config> GetCandidateConfigs(Tensor::DataType dataType, Algorithm algorithm);
+    KernelTuner::Config GetConfig(Tensor::DataType dataType, Algorithm algorithm, bool channelLast,
+        const PushConstants& pushConstants);
+    rad::Ref<ComputeKernel> CreateKernel(Tensor::DataType dataType, Algorithm algorithm, bool channelLast,
+        const KernelTuner::Config& config);
+    ComputeKernel* GetKernel(Tensor::DataType dataType, Algorithm algorithm, bool channelLast,
+        const KernelTuner::Config& config);
+    // Validate the tensors and fill the push constants; return false on errors.
+    bool SetupPushConstants(Tensor* input, Tensor* filter, Tensor* bias, Tensor* output,
+        const Desc& desc, Algorithm algorithm, PushConstants& pushConstants, bool& channelLast);
+    // Return false if the dispatch fails; descSet must be kept alive until the commands complete.
+    bool CmdRun(CommandBuffer* cmdBuffer, ComputeKernel* kernel, Algorithm algorithm,
+        Tensor* input, Tensor* filter, Tensor* bias, Tensor* output, const PushConstants& pushConstants,
+        rad::Ref<DescriptorSet>& descSet);
+
+    rad::Ref<Context> m_context;
+    rad::Ref<KernelTuner> m_tuner;
+    std::map<std::tuple<Tensor::DataType, Algorithm, bool, KernelTuner::Config>,
+        rad::Ref<ComputeKernel>> m_kernels;
+
+}; // class Convolution
+
+} // namespace vkpp
@@ -0,0 +1,266 @@
+#include <vkpp/Compute/KernelTuner.h>
+#include <rad/IO/File.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+
+namespace vkpp
+{
+
+KernelTuner::KernelTuner(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+    const std::string fileName = GetDatabaseFileName(m_context->GetDevice()->GetPhysicalDevice());
+    if (Load(fileName))
+    {
+        VKPP_LOG(info, "KernelTuner: loaded {} entries from {}", m_database.size(), fileName);
+    }
+}
+
+KernelTuner::~KernelTuner()
+{
+}
+
+std::string KernelTuner::GetDatabaseFileName(const PhysicalDevice* physicalDevice)
+{
+    char fileName[64] = {};
+    std::snprintf(fileName, sizeof(fileName), "KernelTuning-%04X-%04X-%08X.txt",
+        physicalDevice->GetVendorID(), physicalDevice->GetDeviceID(),
+        physicalDevice->m_properties.driverVersion);
+    return fileName;
+}
+
+bool KernelTuner::Load(std::string_view fileName)
+{
+    if (!std::filesystem::exists(fileName))
+    {
+        return false;
+    }
+    std::istringstream stream(rad::File::ReadAll(std::string(fileName)));
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+        ++lineNumber;
+        if (line.empty() || (line[0] == '#'))
+        {
+            continue;
+        }
+        std::istringstream lineStream(line);
+        std::string kernelName;
+        std::string shapeBucket;
+        Config config;
+        uint32_t value = 0;
+        lineStream >> kernelName >> shapeBucket;
+        while (lineStream >> value)
+        {
+            config.push_back(value);
+        }
+        if (kernelName.empty() || shapeBucket.empty() || config.empty() || !lineStream.eof())
+        {
+            VKPP_LOG(warn, "KernelTuner: invalid entry at {}:{}", fileName, lineNumber);
+            continue;
+        }
+        m_database[{ std::move(kernelName), std::move(shapeBucket) }] = std::move(config);
+    }
+    return true;
+}
+
+bool KernelTuner::Save(std::string_view fileName) const
+{
+    const PhysicalDevice* physicalDevice = m_context->GetDevice()->GetPhysicalDevice();
+    std::string content = "# ";
+    content += physicalDevice->GetDeviceName();
+    content += "\n";
+    for (const auto& [key, config] : m_database)
+    {
+        content += key.first;
+        content += " ";
+        content += key.second;
+        for (uint32_t value : config)
+        {
+            content += " ";
+            content += std::to_string(value);
+        }
+        content += "\n";
+    }
+
+    rad::File file;
+    if (!file.Open(std::string(fileName), "wb"))
+    {
+        VKPP_LOG(err, "KernelTuner: failed to open {}", fileName);
+        return false;
+    }
+    file.Write(content.data(), content.size());
+    file.Close();
+    return true;
+}
+
+std::string KernelTuner::GetShapeBucket(rad::Span<uint64_t> sizes)
+{
+    std::string bucket;
+    for (uint64_t size : sizes)
+    {
+        if (!bucket.empty())
+        {
+            bucket += "x";
+        }
+        bucket += "2^";
+        bucket += std::to_string((size > 1) ? std::bit_width(size - 1) : 0);
+    }
+    return bucket;
+}
+
+const KernelTuner::Config* KernelTuner::Find(std::string_view kernelName, std::string_view shapeBucket) const
+{
+    auto iter = m_database.find({ std::string(kernelName), std::string(shapeBucket) });
+    if (iter != m_database.end())
+    {
+        return &iter->second;
+    }
+    return nullptr;
+}
+
+void KernelTuner::Set(std::string_view kernelName, std::string_view shapeBucket, Config config)
+{
+    m_database[{ std::string(kernelName), std::string(shapeBucket) }] = std::move(config);
+}
+
+bool KernelTuner::IsTimestampSupported() const
+{
+    const VkQueueFamilyProperties& properties =
+        m_context->GetQueue()->GetQueueFamilyProperties();
+    return (properties.timestampValidBits > 0) &&
+        (m_context->GetDevice()->GetLimits().timestampPeriod > 0.0f);
+}
+
+KernelTuner::Config KernelTuner::Tune(std::string_view kernelName, std::string_view shapeBucket,
+    rad::Span<Config> candidates, const CreateKernelCallback& createKernel,
+    const RecordCallback& record, uint32_t iterationCount)
+{
+    if (!IsTimestampSupported())
+    {
+        VKPP_LOG(err, "KernelTuner: timestamps are not supported by the queue!");
+        return {};
+    }
+
+    Config bestConfig;
+    double bestTime = std::numeric_limits<double>::max();
+    for (const Config& config : candidates)
+    {
+        rad::Ref<ComputeKernel> kernel = createKernel(config);
+        if (!kernel)
+        {
+            continue;
+        }
+        double time = Measure(kernel.get(), record, std::max(iterationCount, 1u));
+        std::string values;
+        for (uint32_t value : config)
+        {
+            values += values.empty() ? "" : " ";
+            values += std::to_string(value);
+        }
+        VKPP_LOG(debug, "KernelTuner: {} {} ({}): {:.3f} us", kernelName, shapeBucket, values, time / 1000.0);
+        if ((time >= 0.0) && (time < bestTime))
+        {
+            bestTime = time;
+            bestConfig = config;
+        }
+    }
+
+    if (!bestConfig.empty())
+    {
+        Set(kernelName, shapeBucket, bestConfig);
+    }
+    return bestConfig;
+}
+
+std::vector<KernelTuner::Config> KernelTuner::GetLocalSizeCandidates(const Config& baseConfig) const
+{
+    const VkPhysicalDeviceLimits& limits = m_context->GetDevice()->GetLimits();
+    const uint32_t maxLocalSize = std::min(
+        limits.maxComputeWorkGroupInvocations, limits.maxComputeWorkGroupSize[0]);
+    std::vector<Config> candidates;
+    for (uint32_t localSize = 64; localSize <= maxLocalSize; localSize *= 2)
+    {
+        Config config = baseConfig;
+        if (config.empty())
+        {
+            config.push_back(localSize);
+        }
+        else
+        {
+            config[0] = localSize;
+        }
+        candidates.push_back(std::move(config));
+    }
+    return candidates;
+}
+
+double KernelTuner::Measure(ComputeKernel* kernel, const RecordCallback& record, uint32_t iterationCount)
+{
+    if (!m_queryPool)
+    {
+        m_queryPool = m_context->GetDevice()->CreateQueryPool(VK_QUERY_TYPE_TIMESTAMP, 2);
+    }
+
+    // Runs may write the same buffers.
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    std::vector<rad::Ref<DescriptorSet>> descSets;
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    cmdBuffer->ResetQueryPool(m_queryPool.get(), 0, 2);
+    // The warm-up run is not timed: caches are cold and the pipeline may be compiled lazily.
+    if (!record(cmdBuffer.get(), kernel, descSets.emplace_back()))
+    {
+        cmdBuffer->End();
+        return -1.0;
+    }
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        barrier, {}, {});
+    // Written when the warm-up run completes.
+    cmdBuffer->WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool.get(), 0);
+    for (uint32_t i = 0; i < iterationCount; ++i)
+    {
+        if (i > 0)
+        {
+            cmdBuffer->SetPipelineBarrier(
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0,
+                barrier, {}, {});
+        }
+        if (!record(cmdBuffer.get(), kernel, descSets.emplace_back()))
+        {
+            cmdBuffer->End();
+            return -1.0;
+        }
+    }
+    cmdBuffer->WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool.get(), 1);
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+
+    uint64_t timestamps[2] = {};
+    if (!m_queryPool->GetResults(0, 2, timestamps))
+    {
+        return -1.0;
+    }
+    const uint32_t validBits = m_context->GetQueue()->GetQueueFamilyProperties().timestampValidBits;
+    const uint64_t mask = (validBits >= 64) ? ~uint64_t(0) : ((uint64_t(1) << validBits) - 1);
+    const uint64_t ticks = (timestamps[1] - timestamps[0]) & mask;
+    return double(ticks) * m_context->GetDevice()->GetLimits().timestampPeriod / iterationCount;
+}
+
+} // namespace vkpp
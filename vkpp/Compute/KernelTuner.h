@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <functional>
+#include <map>
+
+namespace vkpp
+{
+
+// Tune the specialization constants of kernels (workgroup and tile sizes) for the shapes they run with:
+// each candidate is timed with timestamp queries and the fastest is recorded in a tuning database,
+// which is specific to the device and driver (see GetDatabaseFileName).
+// Kernels consult the database with Find, and fall back to their defaults if there is no entry;
+// currently only Convolution is tunable (see Convolution::SetTuner).
+// The constructor loads the database of the device from the working directory if it exists;
+// call Save(GetDatabaseFileName(...)) to keep the results of Tune.
+class KernelTuner : public rad::RefCounted<KernelTuner>
+{
+public:
+    // Values of the specialization constants: [0] is the local size (local_size_x_id = 0),
+    // the others are constant_id = 1, 2, ... (see ComputeKernel::SetSpecializationConstants).
+    using Config = std::vector<uint32_t>;
+    // Create the kernel of a candidate; return nullptr if the candidate is not supported.
+    using CreateKernelCallback = std::function<rad::Ref<ComputeKernel>(const Config& config)>;
+    // Record a run of the kernel; return false on failure. The descriptor set (if any, nullptr with push descriptors)
+    // is kept alive until the commands complete.
+    using RecordCallback = std::function<bool(CommandBuffer* cmdBuffer, ComputeKernel* kernel,
+        rad::Ref<DescriptorSet>& descSet)>;
+
+    KernelTuner(rad::Ref<Context> context);
+    ~KernelTuner();
+    VKPP_DISABLE_COPY_AND_MOVE(KernelTuner);
+
+    // Identify the device and driver, since the best configs of one do not apply to another:
+    // "KernelTuning-<vendorID>-<deviceID>-<driverVersion>.txt" (hexadecimal).
+    static std::string GetDatabaseFileName(const PhysicalDevice* physicalDevice);
+    // Each line is "<kernel name> <shape bucket> <config values>"; lines starting with '#' are ignored.
+    // Entries loaded replace the existing entries of the same key.
+    bool Load(std::string_view fileName);
+    bool Save(std::string_view fileName) const;
+
+    // Shapes are grouped by the power of two (rounded up) of each size: "2^20x2^9" for (1000000, 300).
+    static std::string GetShapeBucket(rad::Span<uint64_t> sizes);
+
+    // @param kernelName: identifies the shader and its macros, without whitespace.
+    // Return nullptr if the kernel has not been tuned for the bucket.
+    const Config* Find(std::string_view kernelName, std::string_view shapeBucket) const;
+    void Set(std::string_view kernelName, std::string_view shapeBucket, Config config);
+
+    bool IsTimestampSupported() const;
+    // Time each candidate (iterationCount runs after a warm-up run), set the fastest for the key and return it;
+    // return an empty config if no candidate can run.
+    Config Tune(std::string_view kernelName, std::string_view shapeBucket,
+        rad::Span<Config> candidates, const CreateKernelCallback& createKernel,
+        const RecordCallback& record, uint32_t iterationCount = 8);
+
+    // Local sizes from 64 to the device limit (powers of two), with the other values of the base config.
+    std::vector<Config> GetLocalSizeCandidates(const Config& baseConfig) const;
+
+private:
+    // Return the average time of a run in nanoseconds, or a negative value on failure.
+    double Measure(ComputeKernel* kernel, const RecordCallback& record, uint32_t iterationCount);
+
+    rad::Ref<Context> m_context;
+    rad::Ref<QueryPool> m_queryPool;
+    std::map<std::pair<std::string, std::string>, Config> m_database;
+
+}; // class KernelTuner
+
+} // namespace vkpp
@@ -0,0 +1,156 @@
+#include <vkpp/Compute/Pooling.h>
+
+namespace vkpp
+{
+
+Pooling::Pooling(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+Pooling::~Pooling()
+{
+}
+
+std::vector<uint64_t> Pooling::GetOutputSizes(rad::Span<uint64_t> inputSizes, const Desc& desc)
+{
+    assert((inputSizes.size() == 4) || (inputSizes.size() == 5));
+    std::vector<uint64_t> outputSizes = { inputSizes[0], inputSizes[1] };
+    const size_t spatialDims = inputSizes.size() - 2;
+    for (size_t i = 0; i < spatialDims; ++i)
+    {
+        // Skip D of 2D pooling.
+        const size_t axis = 3 - spatialDims + i;
+        uint64_t paddedSize = inputSizes[2 + i] + 2 * uint64_t(desc.padding[axis]);
+        outputSizes.push_back((paddedSize >= desc.kernelSize[axis]) ?
+            (paddedSize - desc.kernelSize[axis]) / desc.strides[axis] + 1 : 0);
+    }
+    return outputSizes;
+}
+
+ComputeKernel* Pooling::GetKernel(Tensor::DataType dataType, Mode mode, bool channelLast)
+{
+    auto key = std::make_tuple(dataType, mode, channelLast);
+    auto iter = m_kernels.find(key);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    macros.emplace_back("CHANNEL_LAST", channelLast ? 1u : 0u);
+    macros.emplace_back("POOLING_MODE", static_cast<uint32_t>(mode));
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetDeviceAddressArguments();
+    if (!kernel->Init("Compute/Pooling.comp", macros, 2, sizeof(PushConstants)))
+    {
+        return nullptr;
+    }
+    m_kernels[key] = kernel;
+    return kernel.get();
+}
+
+bool Pooling::Run(Tensor* input, Tensor* output, const Desc& desc)
+{
+    // Max pooling of quantized 8-bit tensors is exact on the quantized values.
+    const bool isQuantizedMax = (desc.mode == Mode::Max) &&
+        ((input->m_dataType == Tensor::DataType::Sint8) || (input->m_dataType == Tensor::DataType::Uint8));
+    if ((!Tensor::IsFloatingPoint(input->m_dataType) && !isQuantizedMax) ||
+        (output->m_dataType != input->m_dataType))
+    {
+        VKPP_LOG(err, "Pooling: data types mismatch or not supported!");
+        return false;
+    }
+
+    const bool channelLast = ComputeKernel::IsChannelLast(input);
+    uint32_t inputShape[5] = {};
+    uint32_t outputShape[5] = {};
+    if (!ComputeKernel::GetSpatialShape(input, channelLast, inputShape) ||
+        !ComputeKernel::GetSpatialShape(output, channelLast, outputShape))
+    {
+        VKPP_LOG(err, "Pooling: tensors must be contiguous in the same layout (NCHW/NHWC/NCDHW/NDHWC)!");
+        return false;
+    }
+    // D is ignored for 4D tensors.
+    for (size_t axis = (input->GetNumDimensions() == 5) ? 0 : 1; axis < 3; ++axis)
+    {
+        if ((desc.kernelSize[axis] == 0) || (desc.strides[axis] == 0))
+        {
+            VKPP_LOG(err, "Pooling: kernel sizes and strides must not be zero!");
+            return false;
+        }
+    }
+    if (output->m_sizes != GetOutputSizes(input->m_sizes, desc))
+    {
+        VKPP_LOG(err, "Pooling: invalid sizes!");
+        return false;
+    }
+    if (output->GetElementCount() == 0)
+    {
+        return true;
+    }
+
+    ComputeKernel* kernel = GetKernel(input->m_dataType, desc.mode, channelLast);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    // D of 2D pooling: size 1, no padding.
+    const bool is3D = (input->GetNumDimensions() == 5);
+    PushConstants pushConstants = {};
+    pushConstants.N = inputShape[0];
+    pushConstants.C = inputShape[1];
+    pushConstants.D = inputShape[2];
+    pushConstants.H = inputShape[3];
+    pushConstants.W = inputShape[4];
+    pushConstants.OD = outputShape[2];
+    pushConstants.OH = outputShape[3];
+    pushConstants.OW = outputShape[4];
+    pushConstants.KD = is3D ? desc.kernelSize[0] : 1;
+    pushConstants.KH = desc.kernelSize[1];
+    pushConstants.KW = desc.kernelSize[2];
+    pushConstants.strideD = is3D ? desc.strides[0] : 1;
+    pushConstants.strideH = desc.strides[1];
+    pushConstants.strideW = desc.strides[2];
+    pushConstants.padD = is3D ? desc.padding[0] : 0;
+    pushConstants.padH = desc.padding[1];
+    pushConstants.padW = desc.padding[2];
+    pushConstants.outputCount = static_cast<uint32_t>(output->GetElementCount());
+    pushConstants.flags = desc.countIncludePad ? FlagCountIncludePad : 0;
+
+    rad::Ref<DescriptorSet> descSet;
+    if (kernel->UsesDeviceAddresses())
+    {
+        pushConstants.inputData = input->GetDeviceAddress();
+        pushConstants.outputData = output->GetDeviceAddress();
+        if ((pushConstants.inputData == 0) || (pushConstants.outputData == 0))
+        {
+            VKPP_LOG(err, "Pooling: the buffers have no device address!");
+            return false;
+        }
+    }
+    else
+    {
+        descSet = kernel->AllocateDescriptorSet(
+            {
+                input->GetDescriptorInfo(),
+                output->GetDescriptorInfo(),
+            });
+    }
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    if (!kernel->Dispatch(cmdBuffer.get(), descSet.get(), &pushConstants,
+        kernel->GetGroupCount(pushConstants.outputCount)))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+} // namespace vkpp
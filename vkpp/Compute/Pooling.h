@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <array>
+#include <map>
+#include <tuple>
+
+namespace vkpp
+{
+
+// 2D/3D max/average pooling of floating point tensors,
+// in NCHW/NHWC or NCDHW/NDHWC layout (see Convolution).
+// Max pooling also supports 8-bit (quantized) integer tensors.
+class Pooling : public rad::RefCounted<Pooling>
+{
+public:
+    enum class Mode : uint32_t
+    {
+        Max,
+        Average,
+    };
+
+    // Spatial parameters are in (D, H, W) order; D is ignored for 4D tensors.
+    struct Desc
+    {
+        Mode mode = Mode::Max;
+        std::array<uint32_t, 3> kernelSize = { 1, 1, 1 };
+        std::array<uint32_t, 3> strides = { 1, 1, 1 };
+        std::array<uint32_t, 3> padding = { 0, 0, 0 };
+        // Include the padding in the divisor of average pooling.
+        bool countIncludePad = false;
+    };
+
+    Pooling(rad::Ref<Context> context);
+    ~Pooling();
+    VKPP_DISABLE_COPY_AND_MOVE(Pooling);
+
+    static std::vector<uint64_t> GetOutputSizes(rad::Span<uint64_t> inputSizes, const Desc& desc);
+
+    // output and input must have the same layout.
+    bool Run(Tensor* input, Tensor* output, const Desc& desc);
+
+private:
+    // Must match Pooling.comp.
+    struct PushConstants
+    {
+        // If ComputeKernel::UsesDeviceAddresses().
+        VkDeviceAddress inputData;
+        VkDeviceAddress outputData;
+        uint32_t N, C, D, H, W;
+        uint32_t OD, OH, OW;
+        uint32_t KD, KH, KW;
+        uint32_t strideD, strideH, strideW;
+        uint32_t padD, padH, padW;
+        uint32_t outputCount;
+        uint32_t flags;
+    };
+
+    static constexpr uint32_t FlagCountIncludePad = 0x1;
+
+    ComputeKernel* GetKernel(Tensor::DataType dataType, Mode mode, bool channelLast);
+
+    rad::Ref<Context> m_context;
+    std::map<std::tuple<Tensor::DataType, Mode, bool>, rad::Ref<ComputeKernel>> m_kernels;
+
+}; // class Pooling
+
+} // namespace vkpp
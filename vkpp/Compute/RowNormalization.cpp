@@ -0,0 +1,130 @@
+#include <vkpp/Compute/RowNormalization.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+RowNormalization::RowNormalization(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+RowNormalization::~RowNormalization()
+{
+}
+
+ComputeKernel* RowNormalization::GetKernel(Tensor::DataType dataType, Operation operation)
+{
+    auto key = std::make_pair(dataType, operation);
+    auto iter = m_kernels.find(key);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    macros.emplace_back("OPERATION", static_cast<uint32_t>(operation));
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetRequiredSubgroupSize();
+    kernel->SetPushDescriptorArguments();
+    if (!kernel->Init("Compute/RowNormalization.comp", macros, 4, sizeof(PushConstants)))
+    {
+        return nullptr;
+    }
+    m_kernels[key] = kernel;
+    return kernel.get();
+}
+
+bool RowNormalization::Softmax(Tensor* input, Tensor* output)
+{
+    return Run(Operation::Softmax, input, output, nullptr, nullptr, 0.0f);
+}
+
+bool RowNormalization::LayerNorm(Tensor* input, Tensor* output,
+    Tensor* gamma, Tensor* beta, float epsilon)
+{
+    return Run(Operation::LayerNorm, input, output, gamma, beta, epsilon);
+}
+
+bool RowNormalization::RMSNorm(Tensor* input, Tensor* output, Tensor* gamma, float epsilon)
+{
+    return Run(Operation::RMSNorm, input, output, gamma, nullptr, epsilon);
+}
+
+bool RowNormalization::Run(Operation operation, Tensor* input, Tensor* output,
+    Tensor* gamma, Tensor* beta, float epsilon)
+{
+    assert(Tensor::IsFloatingPoint(input->m_dataType));
+    assert(input->m_dataType == output->m_dataType);
+    assert(input->m_sizes == output->m_sizes);
+    if (!Tensor::IsFloatingPoint(input->m_dataType) ||
+        (input->m_dataType != output->m_dataType) || (input->m_sizes != output->m_sizes))
+    {
+        VKPP_LOG(err, "RowNormalization: data type or sizes mismatch!");
+        return false;
+    }
+
+    PushConstants pushConstants = {};
+    uint32_t outputSizes[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(input, pushConstants.sizes, pushConstants.inputStrides) ||
+        !ComputeKernel::GetTensorShape(output, outputSizes, pushConstants.outputStrides))
+    {
+        VKPP_LOG(err, "RowNormalization: tensor shape is not supported!");
+        return false;
+    }
+
+    const uint64_t rowLength = input->m_sizes.back();
+    if (input->GetElementCount() == 0)
+    {
+        return true;
+    }
+    for (Tensor* param : { gamma, beta })
+    {
+        if (param && ((param->m_dataType != input->m_dataType) ||
+            (param->GetNumDimensions() != 1) || (param->m_sizes[0] != rowLength) ||
+            (param->m_strides[0] != 1)))
+        {
+            VKPP_LOG(err, "RowNormalization: gamma/beta must be 1D contiguous tensors of the row length!");
+            return false;
+        }
+    }
+
+    ComputeKernel* kernel = GetKernel(input->m_dataType, operation);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    pushConstants.numDims = static_cast<uint32_t>(input->GetNumDimensions());
+    pushConstants.rowCount = static_cast<uint32_t>(input->GetElementCount() / rowLength);
+    pushConstants.epsilon = epsilon;
+    pushConstants.flags = (gamma ? FlagGamma : 0) | (beta ? FlagBeta : 0);
+
+    // One workgroup per row.
+    uint32_t groupCount = std::min(pushConstants.rowCount,
+        m_context->GetDevice()->GetLimits().maxComputeWorkGroupCount[0]);
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    // Bind the input in place of the missing parameters, they are not accessed.
+    rad::Ref<DescriptorSet> descSet;
+    if (!kernel->DispatchWithBuffers(cmdBuffer.get(),
+        {
+            input->GetDescriptorInfo(),
+            output->GetDescriptorInfo(),
+            (gamma ? gamma : input)->GetDescriptorInfo(),
+            (beta ? beta : input)->GetDescriptorInfo(),
+        },
+        &pushConstants, descSet, std::max(groupCount, 1u)))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+} // namespace vkpp
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+
+namespace vkpp
+{
+
+// Normalize the rows (the last dimension) of floating point tensors in a single kernel:
+// each row is read and written once (rows longer than ComputeKernel::m_localSize * 8 elements
+// read the remaining part again); statistics are accumulated in fp32.
+// Input and output must have the same data type and sizes, and can be the same tensor.
+// The operations return false on errors.
+class RowNormalization : public rad::RefCounted<RowNormalization>
+{
+public:
+    enum class Operation : uint32_t
+    {
+        Softmax,
+        LayerNorm,
+        RMSNorm,
+    };
+
+    RowNormalization(rad::Ref<Context> context);
+    ~RowNormalization();
+    VKPP_DISABLE_COPY_AND_MOVE(RowNormalization);
+
+    // y = exp(x - max(x)) / sum(exp(x - max(x)))
+    bool Softmax(Tensor* input, Tensor* output);
+    // y = (x - mean(x)) / sqrt(var(x) + epsilon) * gamma + beta
+    // gamma and beta (optional) are 1D contiguous tensors of the row length.
+    bool LayerNorm(Tensor* input, Tensor* output, Tensor* gamma, Tensor* beta, float epsilon = 1e-5f);
+    // y = x / sqrt(mean(x^2) + epsilon) * gamma
+    bool RMSNorm(Tensor* input, Tensor* output, Tensor* gamma, float epsilon = 1e-6f);
+
+private:
+    // Must match RowNormalization.comp.
+    struct PushConstants
+    {
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t inputStrides[ComputeKernel::MaxDimensions];
+        uint32_t outputStrides[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t rowCount;
+        float epsilon;
+        uint32_t flags;
+    };
+
+    static constexpr uint32_t FlagGamma = 0x1;
+    static constexpr uint32_t FlagBeta = 0x2;
+
+    ComputeKernel* GetKernel(Tensor::DataType dataType, Operation operation);
+    bool Run(Operation operation, Tensor* input, Tensor* output,
+        Tensor* gamma, Tensor* beta, float epsilon);
+
+    rad::Ref<Context> m_context;
+    std::map<std::pair<Tensor::DataType, Operation>, rad::Ref<ComputeKernel>> m_kernels;
+
+}; // class RowNormalization
+
+} // namespace vkpp
@@ -0,0 +1,276 @@
+#include <vkpp/Compute/Scan.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+Scan::Scan(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+Scan::~Scan()
+{
+}
+
+rad::Ref<Buffer> Scan::CreateCountBuffer()
+{
+    return m_context->GetDevice()->CreateBuffer(sizeof(CompactionCount),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VMA_MEMORY_USAGE_GPU_ONLY);
+}
+
+ComputeKernel* Scan::GetScanKernel(Tensor::DataType dataType, bool segmented)
+{
+    auto key = std::make_pair(dataType, segmented);
+    auto iter = m_scanKernels.find(key);
+    if (iter != m_scanKernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    macros.emplace_back("SEGMENTED", segmented ? 1u : 0u);
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetRequiredSubgroupSize();
+    // SCAN_THREAD_COUNT of Scan.glsl.
+    if (!kernel->Init("Compute/Scan.comp", macros, 4, sizeof(ScanPushConstants), 256))
+    {
+        return nullptr;
+    }
+    m_scanKernels[key] = kernel;
+    return kernel.get();
+}
+
+ComputeKernel* Scan::GetCompactKernel(Tensor::DataType dataType)
+{
+    auto iter = m_compactKernels.find(dataType);
+    if (iter != m_compactKernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetRequiredSubgroupSize();
+    if (!kernel->Init("Compute/Compact.comp", macros, 6, sizeof(CompactPushConstants), 256))
+    {
+        return nullptr;
+    }
+    m_compactKernels[dataType] = kernel;
+    return kernel.get();
+}
+
+VkDescriptorBufferInfo Scan::CmdResetState(CommandBuffer* cmdBuffer, uint32_t tileCount)
+{
+    const VkDeviceSize stateSize =
+        sizeof(StateHeader) + VkDeviceSize(std::max(tileCount, 1u)) * sizeof(TileState);
+    if (!m_stateBuffer || (m_stateBuffer->GetSize() < stateSize))
+    {
+        VkDeviceSize bufferSize = stateSize;
+        if (m_stateBuffer)
+        {
+            bufferSize = std::max(bufferSize, m_stateBuffer->GetSize() * 2);
+            m_retiredStateBuffers.push_back(std::move(m_stateBuffer));
+        }
+        m_stateBuffer = m_context->GetDevice()->CreateStorageBuffer(bufferSize);
+    }
+
+    // The state may still be used by the previous dispatch in the command buffer.
+    VkMemoryBarrier resetBarrier = {};
+    resetBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    resetBarrier.pNext = nullptr;
+    resetBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    resetBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        resetBarrier, {}, {});
+
+    cmdBuffer->FillBuffer(m_stateBuffer.get(), 0, stateSize, 0);
+
+    VkMemoryBarrier clearBarrier = {};
+    clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    clearBarrier.pNext = nullptr;
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        clearBarrier, {}, {});
+
+    return m_stateBuffer->GetDescriptorInfo(0, stateSize);
+}
+
+rad::Ref<DescriptorSet> Scan::CmdScan(CommandBuffer* cmdBuffer, Tensor::DataType dataType,
+    const VkDescriptorBufferInfo& input, const VkDescriptorBufferInfo& output, uint32_t elementCount,
+    Type type, const VkDescriptorBufferInfo* segmentHeads)
+{
+    if ((dataType != Tensor::DataType::Float32) && (dataType != Tensor::DataType::Sint32) &&
+        (dataType != Tensor::DataType::Uint32))
+    {
+        VKPP_LOG(err, "Scan: data type not supported!");
+        return nullptr;
+    }
+    ComputeKernel* kernel = GetScanKernel(dataType, segmentHeads != nullptr);
+    if (!kernel)
+    {
+        return nullptr;
+    }
+
+    ScanPushConstants pushConstants = {};
+    pushConstants.elementCount = elementCount;
+    pushConstants.tileCount = (elementCount + TileSize - 1) / TileSize;
+    pushConstants.flags = (type == Type::Exclusive) ? FlagExclusive : 0;
+
+    VkDescriptorBufferInfo state = CmdResetState(cmdBuffer, pushConstants.tileCount);
+    // Bind the input in place of the missing head flags, they are not accessed.
+    rad::Ref<DescriptorSet> descSet = kernel->AllocateDescriptorSet(
+        {
+            input,
+            output,
+            state,
+            segmentHeads ? *segmentHeads : input,
+        });
+    // Workgroups take tiles from the counter until all are done.
+    uint32_t groupCount = std::clamp(pushConstants.tileCount, 1u,
+        m_context->GetDevice()->GetLimits().maxComputeWorkGroupCount[0]);
+    if (!kernel->Dispatch(cmdBuffer, descSet.get(), &pushConstants, groupCount))
+    {
+        return nullptr;
+    }
+    return descSet;
+}
+
+rad::Ref<DescriptorSet> Scan::CmdCompact(CommandBuffer* cmdBuffer, Tensor::DataType dataType,
+    const VkDescriptorBufferInfo& input, const VkDescriptorBufferInfo* predicate,
+    const VkDescriptorBufferInfo* outputValues, const VkDescriptorBufferInfo* outputIndices,
+    Buffer* countBuffer, VkDeviceSize countOffset, uint32_t elementCount,
+    uint32_t indirectGroupSize)
+{
+    assert(indirectGroupSize > 0);
+    ComputeKernel* kernel = GetCompactKernel(dataType);
+    if (!kernel)
+    {
+        return nullptr;
+    }
+
+    CompactPushConstants pushConstants = {};
+    pushConstants.elementCount = elementCount;
+    pushConstants.tileCount = (elementCount + TileSize - 1) / TileSize;
+    pushConstants.flags =
+        (predicate ? FlagPredicate : 0) |
+        (outputValues ? FlagOutputValues : 0) |
+        (outputIndices ? FlagOutputIndices : 0);
+    pushConstants.indirectGroupSize = indirectGroupSize;
+
+    // Zero count if there is no element; reset along with the state.
+    cmdBuffer->FillBuffer(countBuffer, countOffset, sizeof(CompactionCount), 0);
+    VkDescriptorBufferInfo state = CmdResetState(cmdBuffer, pushConstants.tileCount);
+    // Bind the input in place of the missing buffers, they are not accessed.
+    rad::Ref<DescriptorSet> descSet = kernel->AllocateDescriptorSet(
+        {
+            input,
+            predicate ? *predicate : input,
+            outputValues ? *outputValues : input,
+            outputIndices ? *outputIndices : input,
+            state,
+            countBuffer->GetDescriptorInfo(countOffset, sizeof(CompactionCount)),
+        });
+    uint32_t groupCount = std::clamp(pushConstants.tileCount, 1u,
+        m_context->GetDevice()->GetLimits().maxComputeWorkGroupCount[0]);
+    if (!kernel->Dispatch(cmdBuffer, descSet.get(), &pushConstants, groupCount))
+    {
+        return nullptr;
+    }
+    return descSet;
+}
+
+bool Scan::Run(Tensor* input, Tensor* output, Type type, Tensor* segmentHeads)
+{
+    if (!input->m_isContiguous || !output->m_isContiguous ||
+        (output->m_dataType != input->m_dataType) ||
+        (output->GetElementCount() != input->GetElementCount()) ||
+        (input->GetElementCount() > UINT32_MAX) ||
+        (segmentHeads && (!segmentHeads->m_isContiguous ||
+            (segmentHeads->GetElementSizeInBytes(segmentHeads->m_dataType) != 4) ||
+            (segmentHeads->GetElementCount() != input->GetElementCount()))))
+    {
+        VKPP_LOG(err, "Scan: tensors must be contiguous with the same element count and type!");
+        return false;
+    }
+
+    VkDescriptorBufferInfo heads = {};
+    if (segmentHeads)
+    {
+        heads = segmentHeads->GetDescriptorInfo();
+    }
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    rad::Ref<DescriptorSet> descSet = CmdScan(cmdBuffer.get(), input->m_dataType,
+        input->GetDescriptorInfo(), output->GetDescriptorInfo(),
+        static_cast<uint32_t>(input->GetElementCount()), type, segmentHeads ? &heads : nullptr);
+    cmdBuffer->End();
+    if (!descSet)
+    {
+        return false;
+    }
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    // Earlier submissions to the queue have completed.
+    m_retiredStateBuffers.clear();
+    return true;
+}
+
+uint32_t Scan::Compact(Tensor* input, Tensor* predicate, Tensor* outputValues, Tensor* outputIndices)
+{
+    if (!input->m_isContiguous || (input->GetElementCount() > UINT32_MAX) ||
+        (predicate && (!predicate->m_isContiguous ||
+            (predicate->GetElementSizeInBytes(predicate->m_dataType) != 4) ||
+            (predicate->GetElementCount() != input->GetElementCount()))) ||
+        (outputValues && (!outputValues->m_isContiguous ||
+            (outputValues->m_dataType != input->m_dataType) ||
+            (outputValues->GetElementCount() < input->GetElementCount()))) ||
+        (outputIndices && (!outputIndices->m_isContiguous ||
+            (outputIndices->GetElementSizeInBytes(outputIndices->m_dataType) != 4) ||
+            (outputIndices->GetElementCount() < input->GetElementCount()))))
+    {
+        VKPP_LOG(err, "Scan: invalid tensors for compaction!");
+        return 0;
+    }
+
+    if (!m_countBuffer)
+    {
+        m_countBuffer = CreateCountBuffer();
+    }
+    VkDescriptorBufferInfo predicateInfo = predicate ? predicate->GetDescriptorInfo() : VkDescriptorBufferInfo{};
+    VkDescriptorBufferInfo valuesInfo = outputValues ? outputValues->GetDescriptorInfo() : VkDescriptorBufferInfo{};
+    VkDescriptorBufferInfo indicesInfo = outputIndices ? outputIndices->GetDescriptorInfo() : VkDescriptorBufferInfo{};
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    rad::Ref<DescriptorSet> descSet = CmdCompact(cmdBuffer.get(), input->m_dataType,
+        input->GetDescriptorInfo(),
+        predicate ? &predicateInfo : nullptr,
+        outputValues ? &valuesInfo : nullptr,
+        outputIndices ? &indicesInfo : nullptr,
+        m_countBuffer.get(), 0, static_cast<uint32_t>(input->GetElementCount()));
+    cmdBuffer->End();
+    if (!descSet)
+    {
+        return 0;
+    }
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    m_retiredStateBuffers.clear();
+
+    CompactionCount count = {};
+    m_context->ReadBuffer(m_countBuffer.get(), &count, 0, sizeof(count));
+    return count.count;
+}
+
+} // namespace vkpp
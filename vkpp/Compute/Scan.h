@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+
+namespace vkpp
+{
+
+// Single-pass prefix sums (decoupled look-back) and stream compaction on the device.
+// The Cmd* functions record into a command buffer without synchronizing the caller's buffers,
+// so that the results can be consumed in the same submission (e.g. by DispatchIndirect);
+// the returned descriptor set must be kept alive until the commands complete; nullptr on failure,
+// in which case the command buffer must not be submitted.
+// Buffer ranges must meet minStorageBufferOffsetAlignment.
+class Scan : public rad::RefCounted<Scan>
+{
+public:
+    enum class Type : uint32_t
+    {
+        Inclusive,
+        Exclusive,
+    };
+
+    // Written by Compact; dispatch is {ceil(count / indirectGroupSize), 1, 1}.
+    struct CompactionCount
+    {
+        VkDispatchIndirectCommand dispatch;
+        uint32_t count;
+    };
+
+    Scan(rad::Ref<Context> context);
+    ~Scan();
+    VKPP_DISABLE_COPY_AND_MOVE(Scan);
+
+    // A buffer for CompactionCount, usable as storage and indirect buffer.
+    rad::Ref<Buffer> CreateCountBuffer();
+
+    // Prefix sums of Float32/Sint32/Uint32 elements.
+    // @param segmentHeads: uint32 flags (optional); a nonzero flag restarts the scan at the element.
+    rad::Ref<DescriptorSet> CmdScan(CommandBuffer* cmdBuffer, Tensor::DataType dataType,
+        const VkDescriptorBufferInfo& input, const VkDescriptorBufferInfo& output, uint32_t elementCount,
+        Type type, const VkDescriptorBufferInfo* segmentHeads = nullptr);
+    // Select the elements with nonzero predicates (uint32), or nonzero elements if predicate is null;
+    // write the selected values and/or indices (uint32) in order, and the CompactionCount.
+    rad::Ref<DescriptorSet> CmdCompact(CommandBuffer* cmdBuffer, Tensor::DataType dataType,
+        const VkDescriptorBufferInfo& input, const VkDescriptorBufferInfo* predicate,
+        const VkDescriptorBufferInfo* outputValues, const VkDescriptorBufferInfo* outputIndices,
+        Buffer* countBuffer, VkDeviceSize countOffset, uint32_t elementCount,
+        uint32_t indirectGroupSize = 256);
+
+    // Contiguous 1D views of tensors (all elements in memory order), submitted and waited.
+    // Run and Compact release the scratch buffers replaced by earlier recordings: commands recorded
+    // by the Cmd* functions must have been submitted to the same queue before.
+    bool Run(Tensor* input, Tensor* output, Type type, Tensor* segmentHeads = nullptr);
+    // Return the number of selected elements, 0 on failure.
+    uint32_t Compact(Tensor* input, Tensor* predicate, Tensor* outputValues, Tensor* outputIndices);
+
+private:
+    // Must match Scan.glsl.
+    struct StateHeader
+    {
+        uint32_t tileCounter;
+        uint32_t reserved[3];
+    };
+    struct TileState
+    {
+        uint32_t status;
+        uint32_t aggregate;
+        uint32_t prefix;
+        uint32_t reserved;
+    };
+    // SCAN_TILE_SIZE of Scan.glsl.
+    static constexpr uint32_t TileSize = 256 * 8;
+
+    // Must match Scan.comp.
+    struct ScanPushConstants
+    {
+        uint32_t elementCount;
+        uint32_t tileCount;
+        uint32_t flags;
+    };
+    static constexpr uint32_t FlagExclusive = 0x1;
+
+    // Must match Compact.comp.
+    struct CompactPushConstants
+    {
+        uint32_t elementCount;
+        uint32_t tileCount;
+        uint32_t flags;
+        uint32_t indirectGroupSize;
+    };
+    static constexpr uint32_t FlagPredicate = 0x1;
+    static constexpr uint32_t FlagOutputValues = 0x2;
+    static constexpr uint32_t FlagOutputIndices = 0x4;
+
+    ComputeKernel* GetScanKernel(Tensor::DataType dataType, bool segmented);
+    ComputeKernel* GetCompactKernel(Tensor::DataType dataType);
+    // Zero the state for tileCount tiles before a dispatch.
+    VkDescriptorBufferInfo CmdResetState(CommandBuffer* cmdBuffer, uint32_t tileCount);
+
+    rad::Ref<Context> m_context;
+    std::map<std::pair<Tensor::DataType, bool>, rad::Ref<ComputeKernel>> m_scanKernels;
+    std::map<Tensor::DataType, rad::Ref<ComputeKernel>> m_compactKernels;
+    rad::Ref<Buffer> m_stateBuffer;
+    // Replaced state buffers, may still be used by recorded commands; released by Run and Compact.
+    std::vector<rad::Ref<Buffer>> m_retiredStateBuffers;
+    rad::Ref<Buffer> m_countBuffer;
+
+}; // class Scan
+
+} // namespace vkpp
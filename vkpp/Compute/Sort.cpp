@@ -0,0 +1,351 @@
+#include <vkpp/Compute/Sort.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+Sort::Sort(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+Sort::~Sort()
+{
+}
+
+ComputeKernel* Sort::GetKernel(KernelType kernelType, Tensor::DataType dataType)
+{
+    auto key = std::make_pair(kernelType, dataType);
+    auto iter = m_kernels.find(key);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    std::string_view shaderFile;
+    uint32_t bufferCount = 0;
+    uint32_t pushConstantSize = sizeof(PushConstants);
+    switch (kernelType)
+    {
+    case KernelType::Histogram:
+        ComputeKernel::AddDataTypeMacros(macros, "KEY_TYPE", dataType);
+        shaderFile = "Compute/RadixSortHistogram.comp";
+        bufferCount = 3;
+        break;
+    case KernelType::Onesweep:
+        ComputeKernel::AddDataTypeMacros(macros, "KEY_TYPE", dataType);
+        shaderFile = "Compute/RadixSortOnesweep.comp";
+        bufferCount = 7;
+        break;
+    case KernelType::TopK:
+        ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+        shaderFile = "Compute/TopK.comp";
+        bufferCount = 3;
+        pushConstantSize = sizeof(TopKPushConstants);
+        break;
+    }
+
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetRequiredSubgroupSize();
+    // RADIX_THREAD_COUNT of RadixSort.glsl.
+    if (!kernel->Init(shaderFile, macros, bufferCount, pushConstantSize, 256))
+    {
+        return nullptr;
+    }
+    if ((kernelType == KernelType::Onesweep) && (kernel->GetMinSubgroupSize() < MinSubgroupSize))
+    {
+        VKPP_LOG(err, "Sort: subgroup size {} is not supported!", kernel->GetMinSubgroupSize());
+        return nullptr;
+    }
+    m_kernels[key] = kernel;
+    return kernel.get();
+}
+
+Buffer* Sort::GetScratchBuffer(rad::Ref<Buffer>& buffer, VkDeviceSize size)
+{
+    if (!buffer || (buffer->GetSize() < size))
+    {
+        VkDeviceSize bufferSize = size;
+        if (buffer)
+        {
+            bufferSize = std::max(bufferSize, buffer->GetSize() * 2);
+            m_retiredBuffers.push_back(std::move(buffer));
+        }
+        buffer = m_context->GetDevice()->CreateStorageBuffer(bufferSize);
+    }
+    return buffer.get();
+}
+
+void Sort::CmdComputeBarrier(CommandBuffer* cmdBuffer)
+{
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        barrier, {}, {});
+}
+
+std::vector<rad::Ref<DescriptorSet>> Sort::CmdSort(CommandBuffer* cmdBuffer, Tensor::DataType keyType,
+    const VkDescriptorBufferInfo& keys, const VkDescriptorBufferInfo* payloads, uint32_t elementCount,
+    Order order, bool initPayloadIndices, const VkDescriptorBufferInfo* compactionCount)
+{
+    std::vector<rad::Ref<DescriptorSet>> descSets;
+    if ((keyType != Tensor::DataType::Float32) && (keyType != Tensor::DataType::Sint32) &&
+        (keyType != Tensor::DataType::Uint32) && (keyType != Tensor::DataType::Float64) &&
+        (keyType != Tensor::DataType::Sint64) && (keyType != Tensor::DataType::Uint64))
+    {
+        VKPP_LOG(err, "Sort: key type not supported!");
+        return descSets;
+    }
+    if (elementCount > MaxElementCount)
+    {
+        VKPP_LOG(err, "Sort: too many elements ({})!", elementCount);
+        return descSets;
+    }
+    if (elementCount == 0)
+    {
+        return descSets;
+    }
+    ComputeKernel* histogramKernel = GetKernel(KernelType::Histogram, keyType);
+    ComputeKernel* onesweepKernel = GetKernel(KernelType::Onesweep, keyType);
+    if (!histogramKernel || !onesweepKernel)
+    {
+        return descSets;
+    }
+
+    // One pass per byte of the keys; the count is even, the results end in the input buffers.
+    const VkDeviceSize keySize = Tensor::GetElementSizeInBytes(keyType);
+    const uint32_t passCount = static_cast<uint32_t>(keySize);
+    const uint32_t tileCount = (elementCount + TileSize - 1) / TileSize;
+    const VkDeviceSize histogramSize = VkDeviceSize(RadixSize) * sizeof(uint32_t);
+    // The tile counter (padded to 16 bytes) and the state of each digit of each tile;
+    // aligned to 256 bytes, the max of minStorageBufferOffsetAlignment.
+    const VkDeviceSize passStateSize =
+        (16 + VkDeviceSize(tileCount) * RadixSize * sizeof(uint32_t) + 255) / 256 * 256;
+    const VkDeviceSize stateSize = histogramSize * passCount + passStateSize * passCount;
+
+    Buffer* stateBuffer = GetScratchBuffer(m_stateBuffer, stateSize);
+    Buffer* tempKeys = GetScratchBuffer(m_tempKeys, keySize * elementCount);
+    Buffer* tempPayloads = payloads ?
+        GetScratchBuffer(m_tempPayloads, sizeof(uint32_t) * VkDeviceSize(elementCount)) : nullptr;
+
+    // The state may still be used by the previous sort in the command buffer.
+    VkMemoryBarrier resetBarrier = {};
+    resetBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    resetBarrier.pNext = nullptr;
+    resetBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    resetBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        resetBarrier, {}, {});
+
+    cmdBuffer->FillBuffer(stateBuffer, 0, stateSize, 0);
+
+    VkMemoryBarrier clearBarrier = {};
+    clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    clearBarrier.pNext = nullptr;
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        clearBarrier, {}, {});
+
+    PushConstants pushConstants = {};
+    pushConstants.elementCount = elementCount;
+    pushConstants.flags =
+        (compactionCount ? FlagIndirectCount : 0) |
+        ((order == Order::Descending) ? FlagDescending : 0);
+    // Bind the keys in place of the missing buffers, they are not accessed.
+    const VkDescriptorBufferInfo countInfo = compactionCount ? *compactionCount : keys;
+
+    rad::Ref<DescriptorSet> histogramSet = histogramKernel->AllocateDescriptorSet(
+        {
+            keys,
+            stateBuffer->GetDescriptorInfo(0, histogramSize * passCount),
+            countInfo,
+        });
+    if (!histogramKernel->Dispatch(cmdBuffer, histogramSet.get(), &pushConstants,
+        histogramKernel->GetGroupCount((elementCount + HistogramItemsPerThread - 1) / HistogramItemsPerThread)))
+    {
+        return {};
+    }
+    descSets.push_back(std::move(histogramSet));
+
+    const VkDescriptorBufferInfo tempKeysInfo = tempKeys->GetDescriptorInfo(0, keySize * elementCount);
+    const VkDescriptorBufferInfo tempPayloadsInfo = tempPayloads ?
+        tempPayloads->GetDescriptorInfo(0, sizeof(uint32_t) * VkDeviceSize(elementCount)) : keys;
+    const VkDescriptorBufferInfo payloadsInfo = payloads ? *payloads : keys;
+    // Workgroups take tiles from the counter until all are done.
+    const uint32_t groupCount = std::clamp(tileCount, 1u,
+        m_context->GetDevice()->GetLimits().maxComputeWorkGroupCount[0]);
+    for (uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        CmdComputeBarrier(cmdBuffer);
+        const bool fromInput = ((pass % 2) == 0);
+        PushConstants passPushConstants = pushConstants;
+        passPushConstants.shift = pass * 8;
+        if (payloads)
+        {
+            passPushConstants.flags |= FlagPayloads;
+            if (initPayloadIndices && (pass == 0))
+            {
+                passPushConstants.flags |= FlagPayloadIndices;
+            }
+        }
+        rad::Ref<DescriptorSet> passSet = onesweepKernel->AllocateDescriptorSet(
+            {
+                fromInput ? keys : tempKeysInfo,
+                fromInput ? tempKeysInfo : keys,
+                fromInput ? payloadsInfo : tempPayloadsInfo,
+                fromInput ? tempPayloadsInfo : payloadsInfo,
+                stateBuffer->GetDescriptorInfo(histogramSize * pass, histogramSize),
+                stateBuffer->GetDescriptorInfo(histogramSize * passCount + passStateSize * pass, passStateSize),
+                countInfo,
+            });
+        if (!onesweepKernel->Dispatch(cmdBuffer, passSet.get(), &passPushConstants, groupCount))
+        {
+            return {};
+        }
+        descSets.push_back(std::move(passSet));
+    }
+    return descSets;
+}
+
+bool Sort::Run(Tensor* keys, Tensor* payloads, Order order, bool initPayloadIndices)
+{
+    if (!keys->m_isContiguous || (keys->GetElementCount() > MaxElementCount) ||
+        (payloads && (!payloads->m_isContiguous ||
+            (Tensor::GetElementSizeInBytes(payloads->m_dataType) != 4) ||
+            (payloads->GetElementCount() != keys->GetElementCount()))))
+    {
+        VKPP_LOG(err, "Sort: tensors must be contiguous with the same element count!");
+        return false;
+    }
+    if (keys->GetElementCount() == 0)
+    {
+        return true;
+    }
+
+    VkDescriptorBufferInfo payloadsInfo = payloads ? payloads->GetDescriptorInfo() : VkDescriptorBufferInfo{};
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    std::vector<rad::Ref<DescriptorSet>> descSets = CmdSort(cmdBuffer.get(), keys->m_dataType,
+        keys->GetDescriptorInfo(), payloads ? &payloadsInfo : nullptr,
+        static_cast<uint32_t>(keys->GetElementCount()), order, initPayloadIndices);
+    cmdBuffer->End();
+    if (descSets.empty())
+    {
+        return false;
+    }
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    // Earlier submissions to the queue have completed.
+    m_retiredBuffers.clear();
+    return true;
+}
+
+bool Sort::TopK(Tensor* input, uint32_t k, uint32_t axis, bool largest, bool sorted,
+    Tensor* values, Tensor* indices)
+{
+    const size_t numDims = input->GetNumDimensions();
+    if ((axis >= numDims) || (k == 0) || (k > input->m_sizes[axis]) || (!values && !indices) ||
+        (sorted && (k > TopKMaxSorted)))
+    {
+        VKPP_LOG(err, "TopK: invalid axis or k!");
+        return false;
+    }
+    std::vector<uint64_t> outputSizes = input->m_sizes;
+    outputSizes[axis] = k;
+    if ((values && ((values->m_dataType != input->m_dataType) || (values->m_sizes != outputSizes))) ||
+        (indices && ((Tensor::GetElementSizeInBytes(indices->m_dataType) != 4) ||
+            (indices->m_sizes != outputSizes))) ||
+        (values && indices && (values->m_strides != indices->m_strides)))
+    {
+        VKPP_LOG(err, "TopK: the outputs must have the input sizes with k along the axis, and the same strides!");
+        return false;
+    }
+
+    Tensor* output = values ? values : indices;
+    uint32_t inputSizes[ComputeKernel::MaxDimensions] = {};
+    uint32_t inputStrides[ComputeKernel::MaxDimensions] = {};
+    uint32_t sizes[ComputeKernel::MaxDimensions] = {};
+    uint32_t outputStrides[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(input, inputSizes, inputStrides) ||
+        !ComputeKernel::GetTensorShape(output, sizes, outputStrides))
+    {
+        VKPP_LOG(err, "TopK: tensor shape is not supported!");
+        return false;
+    }
+
+    // Move the axis to the last dimension, the kernel selects along rows.
+    TopKPushConstants pushConstants = {};
+    uint32_t dim = 0;
+    for (uint32_t i = 0; i < numDims; ++i)
+    {
+        if (i != axis)
+        {
+            pushConstants.sizes[dim] = inputSizes[i];
+            pushConstants.inputStrides[dim] = inputStrides[i];
+            pushConstants.outputStrides[dim] = outputStrides[i];
+            ++dim;
+        }
+    }
+    pushConstants.sizes[dim] = inputSizes[axis];
+    pushConstants.inputStrides[dim] = inputStrides[axis];
+    pushConstants.outputStrides[dim] = outputStrides[axis];
+    pushConstants.numDims = static_cast<uint32_t>(numDims);
+    pushConstants.rowCount = static_cast<uint32_t>(input->GetElementCount() / input->m_sizes[axis]);
+    pushConstants.k = k;
+    pushConstants.flags =
+        (largest ? FlagLargest : 0) |
+        (sorted ? FlagSorted : 0) |
+        (values ? FlagOutputValues : 0) |
+        (indices ? FlagOutputIndices : 0);
+    if (pushConstants.rowCount == 0)
+    {
+        return true;
+    }
+
+    ComputeKernel* kernel = GetKernel(KernelType::TopK, input->m_dataType);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    // Bind the input in place of the missing outputs, they are not accessed.
+    rad::Ref<DescriptorSet> descSet = kernel->AllocateDescriptorSet(
+        {
+            input->GetDescriptorInfo(),
+            (values ? values : input)->GetDescriptorInfo(),
+            (indices ? indices : input)->GetDescriptorInfo(),
+        });
+
+    // One workgroup per row.
+    uint32_t groupCount = std::min(pushConstants.rowCount,
+        m_context->GetDevice()->GetLimits().maxComputeWorkGroupCount[0]);
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    if (!kernel->Dispatch(cmdBuffer.get(), descSet.get(), &pushConstants, groupCount))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    // Earlier submissions to the queue have completed.
+    m_retiredBuffers.clear();
+    return true;
+}
+
+} // namespace vkpp
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+
+namespace vkpp
+{
+
+// Sorting on the device:
+// - Onesweep LSD radix sort of 32/64-bit keys (Float32/Sint32/Uint32/Float64/Sint64/Uint64),
+//   with optional 32-bit payloads; one histogram pass, then one pass per 8-bit digit.
+//   The element count can be read from a Scan::CompactionCount on the device,
+//   so that compacted outputs can be sorted in the same submission.
+// - Top-k along an axis of a tensor by radix select.
+// Floating-point keys are ordered by their bits, NaNs (positive) are larger than +Inf.
+// The Cmd* functions record into a command buffer without synchronizing the caller's buffers;
+// the returned descriptor sets must be kept alive until the commands complete.
+class Sort : public rad::RefCounted<Sort>
+{
+public:
+    enum class Order : uint32_t
+    {
+        Ascending,
+        Descending,
+    };
+
+    // Must match TOPK_MAX_SORTED of TopK.comp.
+    static constexpr uint32_t TopKMaxSorted = 1024;
+
+    Sort(rad::Ref<Context> context);
+    ~Sort();
+    VKPP_DISABLE_COPY_AND_MOVE(Sort);
+
+    // Sort the keys (and payloads) in place, stable.
+    // @param payloads: uint32 values moved with the keys (optional).
+    // @param initPayloadIndices: write the original element indices to payloads instead of reading them (argsort).
+    // @param compactionCount: the range of a Scan::CompactionCount (optional); if specified,
+    //   min(count, elementCount) elements are sorted, and elementCount is the capacity of the buffers.
+    // Return no descriptor set on failure (and if elementCount is 0): the command buffer must not be submitted.
+    std::vector<rad::Ref<DescriptorSet>> CmdSort(CommandBuffer* cmdBuffer, Tensor::DataType keyType,
+        const VkDescriptorBufferInfo& keys, const VkDescriptorBufferInfo* payloads, uint32_t elementCount,
+        Order order = Order::Ascending, bool initPayloadIndices = false,
+        const VkDescriptorBufferInfo* compactionCount = nullptr);
+
+    // Contiguous 1D views of tensors (all elements in memory order), submitted and waited.
+    // Run and TopK release the scratch buffers replaced by earlier recordings: commands recorded
+    // by the Cmd* functions must have been submitted to the same queue before.
+    bool Run(Tensor* keys, Tensor* payloads, Order order = Order::Ascending, bool initPayloadIndices = false);
+
+    // Select the k largest (or smallest) elements along the axis; the outputs have the sizes of the input
+    // except k along the axis, and the same strides (in elements).
+    // @param values, indices: Sint32/Uint32 indices along the axis; either can be null.
+    // @param sorted: sort the selected elements (k <= TopKMaxSorted), ties by the lower indices;
+    //   otherwise they are in the order of the input.
+    bool TopK(Tensor* input, uint32_t k, uint32_t axis, bool largest, bool sorted,
+        Tensor* values, Tensor* indices);
+
+private:
+    // RADIX_ITEMS_PER_THREAD and RADIX_TILE_SIZE of RadixSortOnesweep.comp.
+    static constexpr uint32_t ItemsPerThread = 8;
+    static constexpr uint32_t TileSize = 256 * ItemsPerThread;
+    static constexpr uint32_t RadixSize = 256;
+    // The look-back state keeps counts in 30 bits.
+    static constexpr uint32_t MaxElementCount = (1u << 30) - 1;
+    // Keys counted by each invocation of the histogram pass, to reduce the global atomics.
+    static constexpr uint32_t HistogramItemsPerThread = 16;
+    // RADIX_MAX_RANK_SUBGROUPS of RadixSortOnesweep.comp.
+    static constexpr uint32_t MinSubgroupSize = 256 / 32;
+
+    // Must match RadixSortHistogram.comp and RadixSortOnesweep.comp.
+    struct PushConstants
+    {
+        uint32_t elementCount;
+        uint32_t shift;
+        uint32_t flags;
+    };
+    static constexpr uint32_t FlagIndirectCount = 0x1;
+    static constexpr uint32_t FlagDescending = 0x2;
+    static constexpr uint32_t FlagPayloads = 0x4;
+    static constexpr uint32_t FlagPayloadIndices = 0x8;
+
+    // Must match TopK.comp.
+    struct TopKPushConstants
+    {
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t inputStrides[ComputeKernel::MaxDimensions];
+        uint32_t outputStrides[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t rowCount;
+        uint32_t k;
+        uint32_t flags;
+    };
+    static constexpr uint32_t FlagLargest = 0x1;
+    static constexpr uint32_t FlagSorted = 0x2;
+    static constexpr uint32_t FlagOutputValues = 0x4;
+    static constexpr uint32_t FlagOutputIndices = 0x8;
+
+    enum class KernelType : uint32_t
+    {
+        Histogram,
+        Onesweep,
+        TopK,
+    };
+
+    ComputeKernel* GetKernel(KernelType kernelType, Tensor::DataType dataType);
+    // Return a buffer of at least size bytes, replacing buffer if it is too small.
+    Buffer* GetScratchBuffer(rad::Ref<Buffer>& buffer, VkDeviceSize size);
+    void CmdComputeBarrier(CommandBuffer* cmdBuffer);
+
+    rad::Ref<Context> m_context;
+    std::map<std::pair<KernelType, Tensor::DataType>, rad::Ref<ComputeKernel>> m_kernels;
+    rad::Ref<Buffer> m_tempKeys;
+    rad::Ref<Buffer> m_tempPayloads;
+    // The histograms of all passes, then the look-back state of each pass.
+    rad::Ref<Buffer> m_stateBuffer;
+    // Replaced scratch buffers, may still be used by recorded commands; released by Run and TopK.
+    std::vector<rad::Ref<Buffer>> m_retiredBuffers;
+
+}; // class Sort
+
+} // namespace vkpp
@@ -1,10 +1,15 @@
 #include <vkpp/Compute/Tensor.h>
+#include <vkpp/Core/MappedFile.h>
 #include <rad/Core/Float16.h>
 #include <rad/Core/Sort.h>
 #include <rad/IO/File.h>
 
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <numeric>
+#include <ostream>
 
 namespace vkpp
 {
@@ -16,6 +21,7 @@ bool Tensor::IsFloatingPoint(DataType dataType)
     case DataType::Float16:
     case DataType::Float32:
     case DataType::Float64:
+    case DataType::BFloat16:
         return true;
     }
     return false;
@@ -67,10 +73,32 @@ uint64_t Tensor::GetElementSizeInBytes(DataType dataType)
     case DataType::Uint16:  return 2;
     case DataType::Uint32:  return 4;
     case DataType::Uint64:  return 8;
+    case DataType::BFloat16: return 2;
     }
     return uint64_t(0);
 }
 
+uint16_t Tensor::BFloat16FromFloat(float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (std::isnan(value))
+    {
+        // Keep NaNs quiet, rounding may turn them into infinity.
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+float Tensor::BFloat16ToFloat(uint16_t value)
+{
+    uint32_t bits = uint32_t(value) << 16;
+    float result = 0;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
 Tensor::Tensor(rad::Ref<Context> context) :
     m_context(std::move(context))
 {
@@ -254,6 +282,105 @@ bool Tensor::CreateBuffer(VkDeviceSize size)
     return true;
 }
 
+bool Tensor::CreateSparseBuffer(VkDeviceSize size)
+{
+    Device* device = m_context->GetDevice();
+    if (!device->IsSparseBufferSupported() || !m_context->GetSparseBindingQueue())
+    {
+        VKPP_LOG(err, "Tensor::CreateSparseBuffer: sparse buffers are not supported!");
+        return false;
+    }
+    m_buffer = device->CreateSparseStorageBuffer(size);
+    m_bufferOffset = 0;
+    m_bufferSize = m_buffer->GetSize();
+    return true;
+}
+
+bool Tensor::Prefetch(VkDeviceSize offset, VkDeviceSize size)
+{
+    assert(offset + size <= m_bufferSize);
+    return m_context->CommitSparseBuffer(m_buffer.get(), m_bufferOffset + offset, size);
+}
+
+bool Tensor::Prefetch()
+{
+    return Prefetch(0, m_bufferSize);
+}
+
+VkDescriptorBufferInfo Tensor::GetDescriptorInfo() const
+{
+    return m_buffer->GetDescriptorInfo(m_bufferOffset, m_bufferSize);
+}
+
+VkDeviceAddress Tensor::GetDeviceAddress() const
+{
+    VkDeviceAddress address = m_buffer->GetDeviceAddress();
+    return (address != 0) ? (address + m_bufferOffset) : 0;
+}
+
+VkDeviceSize Tensor::GetResidentSize() const
+{
+    return (m_buffer && m_buffer->IsDeviceLocal()) ? m_buffer->GetSize() : 0;
+}
+
+bool Tensor::Evict()
+{
+    if (!m_buffer || !m_buffer->IsDeviceLocal())
+    {
+        return false;
+    }
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = m_buffer->GetSize();
+    createInfo.usage = m_buffer->GetUsage();
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+    rad::Ref<Buffer> hostBuffer = m_context->GetDevice()->CreateBuffer(createInfo, allocInfo);
+    if (hostBuffer->IsDeviceLocal())
+    {
+        // Unified memory: nothing to release.
+        return false;
+    }
+    m_context->CopyBuffer(m_buffer.get(), hostBuffer.get(),
+        VkBufferCopy{ 0, 0, createInfo.size });
+    m_buffer = std::move(hostBuffer);
+    return true;
+}
+
+bool Tensor::Restore()
+{
+    if (!m_buffer || m_buffer->IsDeviceLocal())
+    {
+        return true;
+    }
+    rad::Ref<Buffer> deviceBuffer = m_context->GetDevice()->CreateStorageBuffer(m_buffer->GetSize());
+    if (!deviceBuffer->IsDeviceLocal())
+    {
+        return false;
+    }
+    m_context->CopyBuffer(m_buffer.get(), deviceBuffer.get(),
+        VkBufferCopy{ 0, 0, m_buffer->GetSize() });
+    m_buffer = std::move(deviceBuffer);
+    return true;
+}
+
+void Tensor::SetQuantization(float scale, int32_t zeroPoint)
+{
+    m_quantization.axis = -1;
+    m_quantization.scales = { scale };
+    m_quantization.zeroPoints = { zeroPoint };
+}
+
+void Tensor::SetQuantization(int32_t axis, rad::Span<float> scales, rad::Span<int32_t> zeroPoints)
+{
+    assert((axis >= 0) && (size_t(axis) < m_sizes.size()));
+    assert((scales.size() == m_sizes[axis]) && (zeroPoints.size() == scales.size()));
+    m_quantization.axis = axis;
+    m_quantization.scales.assign(scales.begin(), scales.end());
+    m_quantization.zeroPoints.assign(zeroPoints.begin(), zeroPoints.end());
+}
+
 rad::Ref<Tensor> Tensor::CreateTensor(rad::Ref<Context> context, DataType dataType,
     rad::Span<uint64_t> sizes, rad::Span<uint64_t> strides)
 {
@@ -262,14 +389,70 @@ rad::Ref<Tensor> Tensor::CreateTensor(rad::Ref<Context> context, DataType dataTy
     return tensor;
 }
 
-// TODO: Fill methods should be implemented with compute pipeline (ElementWiseUnary).
+rad::Ref<Tensor> Tensor::CreateSparseTensor(rad::Ref<Context> context, DataType dataType,
+    rad::Span<uint64_t> sizes, rad::Span<uint64_t> strides)
+{
+    rad::Ref<Tensor> tensor = RAD_NEW Tensor(context, dataType, sizes, strides);
+    if (!tensor->CreateSparseBuffer(CalculateBufferSize(dataType, sizes, strides)))
+    {
+        return nullptr;
+    }
+    return tensor;
+}
+
+void Tensor::FillPattern(const void* pattern, size_t patternSize)
+{
+    assert(patternSize == GetElementSizeInBytes(m_dataType));
+    assert((patternSize > 0) && (patternSize <= 8));
+    uint64_t bits = 0;
+    std::memcpy(&bits, pattern, patternSize);
+    for (size_t size = patternSize; size < 8; size *= 2)
+    {
+        bits |= bits << (size * 8);
+    }
+
+    if ((uint32_t(bits) == uint32_t(bits >> 32)) &&
+        (m_bufferOffset % 4 == 0) && (m_bufferSize % 4 == 0))
+    {
+        if (!Prefetch())
+        {
+            return;
+        }
+        rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+        cmdBuffer->Begin();
+        cmdBuffer->FillBuffer(m_buffer.get(), m_bufferOffset, m_bufferSize, uint32_t(bits));
+        cmdBuffer->End();
+        m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    }
+    else
+    {
+        m_context->WriteBufferStreamed(m_buffer.get(), m_bufferOffset, m_bufferSize,
+            [bits](void* dest, VkDeviceSize offset, VkDeviceSize size)
+            {
+                uint8_t bytes[8] = {};
+                std::memcpy(bytes, &bits, sizeof(bytes));
+                uint8_t* ptr = static_cast<uint8_t*>(dest);
+                for (VkDeviceSize i = 0; i < size; ++i)
+                {
+                    ptr[i] = bytes[(offset + i) % 8];
+                }
+            });
+    }
+}
 
 void Tensor::FillFloat16(uint16_t value)
 {
     if (m_dataType == DataType::Float16)
     {
-        std::vector<uint16_t> hostBuffer(m_bufferSize / sizeof(uint16_t), value);
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        FillPattern(&value, sizeof(value));
+    }
+}
+
+void Tensor::FillBFloat16(uint16_t value)
+{
+    if (m_dataType == DataType::BFloat16)
+    {
+        FillPattern(&value, sizeof(value));
     }
 }
 
@@ -277,20 +460,19 @@ void Tensor::Fill(float value)
 {
     if (m_dataType == DataType::Float16)
     {
-        std::vector<uint16_t> hostBuffer(m_bufferSize / sizeof(uint16_t),
-            rad::fp16_ieee_from_fp32_value(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        FillFloat16(rad::fp16_ieee_from_fp32_value(value));
+    }
+    else if (m_dataType == DataType::BFloat16)
+    {
+        FillBFloat16(BFloat16FromFloat(value));
     }
     else if (m_dataType == DataType::Float32)
     {
-        std::vector<float> hostBuffer(m_bufferSize / sizeof(float), value);
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        FillPattern(&value, sizeof(value));
     }
     else if (m_dataType == DataType::Float64)
     {
-        static_assert(sizeof(double) == 8);
-        std::vector<double> hostBuffer(m_bufferSize / sizeof(double), value);
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        Fill(static_cast<double>(value));
     }
 }
 
@@ -299,8 +481,7 @@ void Tensor::Fill(double value)
     if (m_dataType == DataType::Float64)
     {
         static_assert(sizeof(double) == 8);
-        std::vector<double> hostBuffer(m_bufferSize / sizeof(double), value);
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        FillPattern(&value, sizeof(value));
     }
     else
     {
@@ -310,25 +491,10 @@ void Tensor::Fill(double value)
 
 void Tensor::Fill(int64_t value)
 {
-    if (m_dataType == DataType::Sint8)
-    {
-        std::vector<int8_t> hostBuffer(m_bufferSize / sizeof(int8_t), int8_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    }
-    else if (m_dataType == DataType::Sint16)
-    {
-        std::vector<int16_t> hostBuffer(m_bufferSize / sizeof(int16_t), int16_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    }
-    else if (m_dataType == DataType::Sint32)
+    if (IsSignedInteger(m_dataType))
     {
-        std::vector<int32_t> hostBuffer(m_bufferSize / sizeof(int32_t), int32_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    }
-    else if (m_dataType == DataType::Sint64)
-    {
-        std::vector<int64_t> hostBuffer(m_bufferSize / sizeof(int64_t), int64_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        // Little endian: the low bytes are the truncated value.
+        FillPattern(&value, GetElementSizeInBytes(m_dataType));
     }
     else
     {
@@ -338,27 +504,11 @@ void Tensor::Fill(int64_t value)
 
 void Tensor::Fill(uint64_t value)
 {
-    if (m_dataType == DataType::Uint8)
-    {
-        std::vector<uint8_t> hostBuffer(m_bufferSize / sizeof(uint8_t), uint8_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    }
-    else if (m_dataType == DataType::Uint16)
+    if (IsUnsignedInteger(m_dataType))
     {
-        std::vector<uint16_t> hostBuffer(m_bufferSize / sizeof(uint16_t), uint16_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
+        FillPattern(&value, GetElementSizeInBytes(m_dataType));
     }
-    else if (m_dataType == DataType::Uint32)
-    {
-        std::vector<uint32_t> hostBuffer(m_bufferSize / sizeof(uint32_t), uint32_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    }
-    else if (m_dataType == DataType::Uint64)
-    {
-        std::vector<uint64_t> hostBuffer(m_bufferSize / sizeof(uint64_t), uint64_t(value));
-        m_context->WriteBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    }
-    else
+    else if (IsSignedInteger(m_dataType))
     {
         Fill(static_cast<int64_t>(value));
     }
@@ -377,9 +527,12 @@ bool Tensor::SaveToFile(std::string_view fileName)
         static_assert(sizeof(VkDeviceSize) == sizeof(uint64_t));
         assert(m_bufferSize == CalculateBufferSize(m_dataType, m_sizes, m_strides));
         file.Write(&m_bufferSize, sizeof(m_bufferSize));
-        std::vector<uint8_t> hostBuffer(m_bufferSize);
-        m_context->ReadBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-        file.Write(hostBuffer.data(), hostBuffer.size());
+        // Stream the payload chunk by chunk, the host never holds the whole tensor.
+        m_context->ReadBufferStreamed(m_buffer.get(), m_bufferOffset, m_bufferSize,
+            [&](const void* src, VkDeviceSize offset, VkDeviceSize size)
+            {
+                file.Write(src, size);
+            });
         file.Close();
         return true;
     }
@@ -389,214 +542,375 @@ bool Tensor::SaveToFile(std::string_view fileName)
 rad::Ref<Tensor> Tensor::CreateFromFile(rad::Ref<Context> context, std::string_view fileName)
 {
     rad::Ref<Tensor> tensor;
-    rad::File file;
-    if (file.Open(fileName, "rb"))
-    {
-        DataType dataType = DataType::Undefined;
-        file.Read(&dataType, sizeof(dataType));
-        uint32_t numDimensions = 0;
-        file.Read(&numDimensions, sizeof(numDimensions));
-        std::vector<uint64_t> sizes(numDimensions);
-        std::vector<uint64_t> strides(numDimensions);
-        file.Read(sizes.data(), sizeof(uint64_t), sizes.size());
-        file.Read(strides.data(), sizeof(uint64_t), strides.size());
-        uint64_t elementCount = GetElementCount(sizes);
-        uint64_t bufferSize = 0;
-        file.Read(&bufferSize, sizeof(bufferSize));
-        if ((dataType != DataType::Undefined) && (numDimensions > 0) &&
-            (elementCount > 0) &&
-            (bufferSize == CalculateBufferSize(dataType, sizes, strides)))
+    MappedFile file;
+    if (!file.Open(fileName))
+    {
+        return nullptr;
+    }
+
+    const uint8_t* data = file.GetData();
+    uint64_t fileSize = file.GetSize();
+    uint64_t readOffset = 0;
+    auto readHeader = [&](void* dest, uint64_t size) -> bool
+    {
+        if (size > fileSize - readOffset)
         {
-            tensor = CreateTensor(context, dataType, sizes, strides);
-            std::vector<uint8_t> hostBuffer(bufferSize);
-            file.Read(hostBuffer.data(), static_cast<uint64_t>(bufferSize));
-            context->WriteBuffer(tensor->m_buffer.get(), hostBuffer.data());
-            file.Close();
+            return false;
         }
-    }
+        memcpy(dest, data + readOffset, size);
+        readOffset += size;
+        return true;
+    };
+
+    DataType dataType = DataType::Undefined;
+    uint32_t numDimensions = 0;
+    if (!readHeader(&dataType, sizeof(dataType)) ||
+        !readHeader(&numDimensions, sizeof(numDimensions)) ||
+        (dataType == DataType::Undefined) || (dataType > DataType::BFloat16) ||
+        (numDimensions == 0) ||
+        (uint64_t(numDimensions) * sizeof(uint64_t) * 2 > fileSize - readOffset))
+    {
+        VKPP_LOG(err, "Tensor::CreateFromFile: invalid header: {}", fileName);
+        return nullptr;
+    }
+
+    std::vector<uint64_t> sizes(numDimensions);
+    std::vector<uint64_t> strides(numDimensions);
+    uint64_t bufferSize = 0;
+    readHeader(sizes.data(), sizes.size() * sizeof(uint64_t));
+    readHeader(strides.data(), strides.size() * sizeof(uint64_t));
+    if (!readHeader(&bufferSize, sizeof(bufferSize)) ||
+        (GetElementCount(sizes) == 0) ||
+        (bufferSize != CalculateBufferSize(dataType, sizes, strides)) ||
+        (bufferSize > fileSize - readOffset))
+    {
+        VKPP_LOG(err, "Tensor::CreateFromFile: invalid header or truncated data: {}", fileName);
+        return nullptr;
+    }
+
+    tensor = CreateTensor(context, dataType, sizes, strides);
+    // Copy from the file mapping straight into the staging memory;
+    // the OS pages the file in as the chunks are consumed.
+    const uint8_t* payload = data + readOffset;
+    context->WriteBufferStreamed(tensor->m_buffer.get(), tensor->m_bufferOffset, bufferSize,
+        [&](void* dest, VkDeviceSize offset, VkDeviceSize size)
+        {
+            memcpy(dest, payload + offset, size);
+        });
     return tensor;
 }
 
-std::string DumpElementReadable(Tensor::DataType dataType, const void* ptr)
+namespace
+{
+
+// Right-align [begin, end) in a field of the given width.
+char* WritePadded(char* dest, const char* begin, const char* end, size_t width)
 {
-    if (dataType == Tensor::DataType::Float16)
+    size_t length = size_t(end - begin);
+    if (length < width)
     {
-        float val = rad::fp16_ieee_to_fp32_value(*static_cast<const uint16_t*>(ptr));
-        return std::format("{:11.4f}", val);
+        std::memset(dest, ' ', width - length);
+        dest += width - length;
     }
-    else if (dataType == Tensor::DataType::Float32)
+    std::memcpy(dest, begin, length);
+    return dest + length;
+}
+
+template <typename T>
+char* WriteInteger(char* dest, T value, size_t width)
+{
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return WritePadded(dest, buffer, result.ptr, width);
+}
+
+template <typename T>
+char* WriteFloat(char* dest, T value, int precision, size_t width)
+{
+    char buffer[64];
+    std::to_chars_result result;
+    if (std::abs(value) < T(INT32_MAX))
     {
-        float val = *static_cast<const float*>(ptr);
-        if (val < float(INT32_MAX))
-        {
-            return std::format("{:18.6f}", val);
-        }
-        else
-        {
-            return std::format("{:18.6e}", val);
-        }
+        result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+            std::chars_format::fixed, precision);
     }
-    else if (dataType == Tensor::DataType::Float64)
+    else
     {
-        double val = *static_cast<const double*>(ptr);
-        if (val < double(INT32_MAX))
-        {
-            return std::format("{:18.6f}", val);
-        }
-        else
-        {
-            return std::format("{:18.6e}", val);
-        }
+        result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+            std::chars_format::scientific, precision);
     }
-    else if (dataType == Tensor::DataType::Sint8)
+    return WritePadded(dest, buffer, result.ptr, width);
+}
+
+template <typename T>
+char* WriteHex(char* dest, T value)
+{
+    static constexpr char digits[] = "0123456789ABCDEF";
+    *dest++ = '0';
+    *dest++ = 'x';
+    for (int shift = int(sizeof(T) * 8) - 4; shift >= 0; shift -= 4)
     {
-        int8_t val = *static_cast<const int8_t*>(ptr);
-        return std::format("{:4}", val);
+        *dest++ = digits[(value >> shift) & 0xF];
     }
-    else if (dataType == Tensor::DataType::Sint16)
+    return dest;
+}
+
+// Maximum number of characters written for an element.
+constexpr size_t MaxElementTextLength = 64;
+
+char* WriteElementReadable(char* dest, Tensor::DataType dataType, const void* ptr)
+{
+    switch (dataType)
     {
-        int16_t val = *static_cast<const int16_t*>(ptr);
-        return std::format("{:6}", val);
+    case Tensor::DataType::Float16:
+        return WriteFloat(dest, rad::fp16_ieee_to_fp32_value(*static_cast<const uint16_t*>(ptr)), 4, 11);
+    case Tensor::DataType::Float32:
+        return WriteFloat(dest, *static_cast<const float*>(ptr), 6, 18);
+    case Tensor::DataType::Float64:
+        return WriteFloat(dest, *static_cast<const double*>(ptr), 6, 18);
+    case Tensor::DataType::Sint8:
+        return WriteInteger(dest, *static_cast<const int8_t*>(ptr), 4);
+    case Tensor::DataType::Sint16:
+        return WriteInteger(dest, *static_cast<const int16_t*>(ptr), 6);
+    case Tensor::DataType::Sint32:
+        return WriteInteger(dest, *static_cast<const int32_t*>(ptr), 11);
+    case Tensor::DataType::Sint64:
+        return WriteInteger(dest, *static_cast<const int64_t*>(ptr), 20);
+    case Tensor::DataType::Uint8:
+        return WriteInteger(dest, *static_cast<const uint8_t*>(ptr), 3);
+    case Tensor::DataType::Uint16:
+        return WriteInteger(dest, *static_cast<const uint16_t*>(ptr), 5);
+    case Tensor::DataType::Uint32:
+        return WriteInteger(dest, *static_cast<const uint32_t*>(ptr), 10);
+    case Tensor::DataType::Uint64:
+        return WriteInteger(dest, *static_cast<const uint64_t*>(ptr), 19);
+    case Tensor::DataType::BFloat16:
+        return WriteFloat(dest, Tensor::BFloat16ToFloat(*static_cast<const uint16_t*>(ptr)), 3, 11);
+    }
+    return dest;
+}
+
+char* WriteElementHex(char* dest, Tensor::DataType dataType, const void* ptr)
+{
+    switch (Tensor::GetElementSizeInBytes(dataType))
+    {
+    case 1: return WriteHex(dest, *static_cast<const uint8_t*>(ptr));
+    case 2: return WriteHex(dest, *static_cast<const uint16_t*>(ptr));
+    case 4: return WriteHex(dest, *static_cast<const uint32_t*>(ptr));
+    case 8: return WriteHex(dest, *static_cast<const uint64_t*>(ptr));
     }
-    else if (dataType == Tensor::DataType::Sint32)
+    return dest;
+}
+
+// Accumulate text in a preallocated buffer; if a stream is attached,
+// the buffer is flushed to it whenever it grows beyond the threshold.
+class DumpWriter
+{
+public:
+    static constexpr size_t FlushThreshold = 1024 * 1024;
+
+    DumpWriter(std::string& buffer, std::ostream* stream) :
+        m_buffer(buffer),
+        m_stream(stream)
     {
-        int32_t val = *static_cast<const int32_t*>(ptr);
-        return std::format("{:11}", val);
     }
-    else if (dataType == Tensor::DataType::Sint64)
+    ~DumpWriter()
     {
-        int64_t val = *static_cast<const int64_t*>(ptr);
-        return std::format("{:20}", val);
+        Flush();
     }
-    else if (dataType == Tensor::DataType::Uint8)
+
+    // Return the position to write at least `size` characters.
+    char* Reserve(size_t size)
     {
-        uint8_t val = *static_cast<const uint8_t*>(ptr);
-        return std::format("{:3}", val);
+        if (m_stream && (m_size + size > FlushThreshold))
+        {
+            Flush();
+        }
+        if (m_size + size > m_buffer.size())
+        {
+            m_buffer.resize(std::max(m_size + size, m_buffer.size() * 2));
+        }
+        return m_buffer.data() + m_size;
     }
-    else if (dataType == Tensor::DataType::Uint16)
+    void Commit(char* end)
     {
-        uint16_t val = *static_cast<const uint16_t*>(ptr);
-        return std::format("{:5}", val);
+        m_size = size_t(end - m_buffer.data());
     }
-    else if (dataType == Tensor::DataType::Uint32)
+    void Write(std::string_view str)
     {
-        uint32_t val = *static_cast<const uint32_t*>(ptr);
-        return std::format("{:10}", val);
+        char* dest = Reserve(str.size());
+        std::memcpy(dest, str.data(), str.size());
+        Commit(dest + str.size());
     }
-    else if (dataType == Tensor::DataType::Uint64)
+    void Flush()
     {
-        uint64_t val = *static_cast<const uint64_t*>(ptr);
-        return std::format("{:19}", val);
+        if (m_stream)
+        {
+            m_stream->write(m_buffer.data(), std::streamsize(m_size));
+            m_size = 0;
+        }
+        else
+        {
+            m_buffer.resize(m_size);
+        }
     }
-    else
+
+private:
+    std::string& m_buffer;
+    std::ostream* m_stream;
+    size_t m_size = 0;
+
+}; // class DumpWriter
+
+std::string GetDimensionLabel(size_t numDimensions, size_t dimIndex)
+{
+    if (numDimensions == 4)
+    {
+        return std::string(1, "NCHW"[dimIndex]);
+    }
+    else if (numDimensions == 5)
     {
-        return std::string();
+        return std::string(1, "NCDHW"[dimIndex]);
     }
+    return "D" + std::to_string(dimIndex);
 }
 
-std::string DumpElementHex(Tensor::DataType dataType, const void* ptr)
+} // namespace
+
+void Tensor::Dump(std::ostream* stream, std::string& buffer, DumpFormat format,
+    rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes)
 {
-    uint64_t elemSize = Tensor::GetElementSizeInBytes(dataType);
-    if (elemSize == 1)
+    assert(m_sizes.size() == dumpOffsets.size());
+    assert(m_sizes.size() == dumpSizes.size());
+    const size_t numDimensions = m_sizes.size();
+    if ((numDimensions == 0) ||
+        (dumpOffsets.size() != numDimensions) || (dumpSizes.size() != numDimensions))
     {
-        uint8_t val = *static_cast<const uint8_t*>(ptr);
-        return std::format("0x{:02X}", val);
+        return;
     }
-    else if (elemSize == 2)
+    for (size_t i = 0; i < numDimensions; ++i)
     {
-        uint16_t val = *static_cast<const uint16_t*>(ptr);
-        return std::format("0x{:04X}", val);
+        if ((dumpSizes[i] == 0) || (dumpOffsets[i] + dumpSizes[i] > m_sizes[i]))
+        {
+            return;
+        }
     }
-    else if (elemSize == 4)
+
+    // Read back only the byte range covered by the window.
+    const uint64_t elemSize = GetElementSizeInBytes(m_dataType);
+    uint64_t firstIndex = 0;
+    uint64_t lastIndex = 0;
+    for (size_t i = 0; i < numDimensions; ++i)
     {
-        uint32_t val = *static_cast<const uint32_t*>(ptr);
-        return std::format("0x{:08X}", val);
+        firstIndex += dumpOffsets[i] * m_strides[i];
+        lastIndex += (dumpOffsets[i] + dumpSizes[i] - 1) * m_strides[i];
     }
-    else if (elemSize == 8)
+    const uint64_t readSize = (lastIndex - firstIndex + 1) * elemSize;
+    std::vector<uint8_t> hostBuffer(readSize);
+    m_context->ReadBuffer(m_buffer.get(), hostBuffer.data(),
+        m_bufferOffset + firstIndex * elemSize, readSize);
+
+    // The last two dimensions are dumped as rows and columns,
+    // outer dimensions are iterated and labeled in the slice header.
+    const size_t colDim = numDimensions - 1;
+    const size_t rowDim = (numDimensions >= 2) ? (numDimensions - 2) : colDim;
+    const size_t numOuterDims = (numDimensions >= 2) ? (numDimensions - 2) : 0;
+    const uint64_t rowCount = (numDimensions >= 2) ? dumpSizes[rowDim] : 1;
+    const uint64_t colCount = dumpSizes[colDim];
+
+    std::vector<std::string> labels(numDimensions);
+    for (size_t i = 0; i < numDimensions; ++i)
     {
-        uint64_t val = *static_cast<const uint64_t*>(ptr);
-        return std::format("0x{:016X}", val);
+        labels[i] = GetDimensionLabel(numDimensions, i);
     }
-    else
+
+    DumpWriter writer(buffer, stream);
+    if (!stream)
     {
-        return std::string();
+        uint64_t elementCount = GetElementCount(dumpSizes);
+        uint64_t sliceCount = elementCount / (rowCount * colCount);
+        size_t elementTextLength = (format == DumpFormat::Readable) ? 24 : size_t(elemSize * 2 + 4);
+        buffer.resize(size_t(elementCount * elementTextLength + sliceCount * 128));
     }
-}
 
-std::string Tensor::Dump(DumpFormat format, rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes)
-{
-    assert(m_sizes.size() == dumpOffsets.size());
-    assert(m_sizes.size() == dumpSizes.size());
-    std::vector<uint8_t*> hostBuffer(m_bufferSize);
-    m_context->ReadBuffer(m_buffer.get(), hostBuffer.data(), m_bufferOffset, m_bufferSize);
-    std::string str;
-    uint64_t numDimensions = m_sizes.size();
-    uint64_t elemSize = GetElementSizeInBytes(m_dataType);
-    if (numDimensions == 4)
+    std::vector<uint64_t> outerIndices(numOuterDims);
+    for (size_t i = 0; i < numOuterDims; ++i)
     {
-        for (uint64_t n = dumpOffsets[0]; n < dumpOffsets[0] + dumpSizes[0]; ++n)
+        outerIndices[i] = dumpOffsets[i];
+    }
+
+    while (true)
+    {
+        // Slice header, e.g. "# N=0; C=1; H=0:4; W=0:4".
+        std::string header = "#";
+        uint64_t sliceIndex = 0;
+        for (size_t i = 0; i < numOuterDims; ++i)
+        {
+            header += " " + labels[i] + "=" + std::to_string(outerIndices[i]) + ";";
+            sliceIndex += outerIndices[i] * m_strides[i];
+        }
+        for (size_t i = numOuterDims; i < numDimensions; ++i)
+        {
+            header += " " + labels[i] + "=" + std::to_string(dumpOffsets[i]) + ":" +
+                std::to_string(dumpOffsets[i] + dumpSizes[i]) + ";";
+        }
+        header.back() = '\n';
+        writer.Write(header);
+
+        for (uint64_t row = 0; row < rowCount; ++row)
         {
-            for (uint64_t c = dumpOffsets[1]; c < dumpOffsets[1] + dumpSizes[1]; ++c)
+            uint64_t rowIndex = sliceIndex;
+            if (numDimensions >= 2)
             {
-                str += std::format("# N={}; C={}; H={}:{}; W={}:{}\n", n, c,
-                    dumpOffsets[2], dumpOffsets[2] + dumpSizes[2],
-                    dumpOffsets[3], dumpOffsets[3] + dumpSizes[3]);
-                for (uint64_t h = dumpOffsets[2]; h < dumpOffsets[2] + dumpSizes[2]; ++h)
+                rowIndex += (dumpOffsets[rowDim] + row) * m_strides[rowDim];
+            }
+            char* dest = writer.Reserve(size_t(colCount * (MaxElementTextLength + 2) + 1));
+            for (uint64_t col = 0; col < colCount; ++col)
+            {
+                uint64_t index = rowIndex + (dumpOffsets[colDim] + col) * m_strides[colDim];
+                const uint8_t* ptr = hostBuffer.data() + (index - firstIndex) * elemSize;
+                if (format == DumpFormat::Readable)
+                {
+                    dest = WriteElementReadable(dest, m_dataType, ptr);
+                }
+                else
                 {
-                    for (uint64_t w = dumpOffsets[3]; w < dumpOffsets[3] + dumpSizes[3]; ++w)
-                    {
-                        uint64_t index = n * m_strides[0] + c * m_strides[1] +
-                            h * m_strides[2] + w * m_strides[3];
-                        uint64_t offset = index * elemSize;
-                        if (format == DumpFormat::Readable)
-                        {
-                            str += DumpElementReadable(m_dataType, hostBuffer.data() + offset) + ", ";
-                        }
-                        else
-                        {
-                            str += DumpElementHex(m_dataType, hostBuffer.data() + offset) + ", ";
-                        }
-                    }
-                    str.pop_back(); // pop the last whitespace
-                    str += "\n";    // next row
+                    dest = WriteElementHex(dest, m_dataType, ptr);
                 }
+                *dest++ = ',';
+                *dest++ = ' ';
             }
+            dest[-1] = '\n'; // next row
+            writer.Commit(dest);
         }
-    }
-    else if (numDimensions == 5)
-    {
-        for (uint64_t n = dumpOffsets[0]; n < dumpOffsets[0] + dumpSizes[0]; ++n)
+
+        // Advance to the next slice.
+        size_t dim = numOuterDims;
+        while (dim > 0)
         {
-            for (uint64_t c = dumpOffsets[1]; c < dumpOffsets[1] + dumpSizes[1]; ++c)
+            --dim;
+            if (++outerIndices[dim] < dumpOffsets[dim] + dumpSizes[dim])
             {
-                for (uint64_t d = dumpOffsets[2]; d < dumpOffsets[2] + dumpSizes[2]; ++d)
-                {
-                    str += std::format("# N={}; C={}; D={}; H={}:{}; W={}:{}\n", n, c, d,
-                        dumpOffsets[3], dumpOffsets[3] + dumpSizes[3],
-                        dumpOffsets[4], dumpOffsets[4] + dumpSizes[4]);
-                    for (uint64_t h = dumpOffsets[3]; h < dumpOffsets[3] + dumpSizes[3]; ++h)
-                    {
-                        for (uint64_t w = dumpOffsets[4]; w < dumpOffsets[4] + dumpSizes[4]; ++w)
-                        {
-                            uint64_t index = n * m_strides[0] + c * m_strides[1] + d * m_strides[2] +
-                                h * m_strides[3] + w * m_strides[4];
-                            uint64_t offset = index * elemSize;
-                            if (format == DumpFormat::Readable)
-                            {
-                                str += DumpElementReadable(m_dataType, hostBuffer.data() + offset) + ", ";
-                            }
-                            else
-                            {
-                                str += DumpElementHex(m_dataType, hostBuffer.data() + offset) + ", ";
-                            }
-                        }
-                        str.pop_back(); // pop the last whitespace
-                        str += "\n";    // next row
-                    }
-                }
+                break;
             }
+            outerIndices[dim] = dumpOffsets[dim];
+            if (dim == 0)
+            {
+                dim = numOuterDims;
+                break;
+            }
+        }
+        if ((numOuterDims == 0) || (dim == numOuterDims))
+        {
+            break;
         }
     }
+}
+
+std::string Tensor::Dump(DumpFormat format, rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes)
+{
+    std::string str;
+    Dump(nullptr, str, format, dumpOffsets, dumpSizes);
     return str;
 }
 
@@ -607,4 +921,18 @@ std::string Tensor::Dump(DumpFormat format)
     return Dump(format, dumpOffsets, dumpSizes);
 }
 
+void Tensor::Dump(std::ostream& stream, DumpFormat format,
+    rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes)
+{
+    std::string buffer;
+    Dump(&stream, buffer, format, dumpOffsets, dumpSizes);
+}
+
+void Tensor::Dump(std::ostream& stream, DumpFormat format)
+{
+    std::vector<uint64_t> dumpOffsets(m_sizes.size(), 0);
+    std::vector<uint64_t> dumpSizes(m_sizes);
+    Dump(stream, format, dumpOffsets, dumpSizes);
+}
+
 } // namespace vkpp
@@ -4,11 +4,12 @@
 #include <vkpp/Core/Math.h>
 #include <rad/Container/SmallVector.h>
 #include <rad/Container/Span.h>
+#include <iosfwd>
 
 namespace vkpp
 {
 
-class Tensor : public rad::RefCounted<Tensor>
+class Tensor : public rad::RefCounted<Tensor>, public ResidentResource
 {
 public:
     enum class DataType : uint32_t
@@ -25,6 +26,8 @@ public:
         Uint16,
         Uint32,
         Uint64,
+        // Stored as uint16_t: the high half of Float32 (1 sign, 8 exponent and 7 mantissa bits).
+        BFloat16,
     };
 
     static bool IsFloatingPoint(DataType dataType);
@@ -32,6 +35,9 @@ public:
     static bool IsUnsignedInteger(DataType dataType);
     static bool IsInteger(DataType dataType);
     static uint64_t GetElementSizeInBytes(DataType dataType);
+    // Round to nearest even.
+    static uint16_t BFloat16FromFloat(float value);
+    static float BFloat16ToFloat(uint16_t value);
 
     Tensor(rad::Ref<Context> context);
     Tensor(rad::Ref<Context> context, DataType dataType,
@@ -73,6 +79,21 @@ public:
     static MemoryLayout GetMemoryLayout(rad::Span<uint64_t> sizes, rad::Span<uint64_t> strides);
     MemoryLayout m_memLayout = MemoryLayout::Unknown;
 
+    // Affine quantization of integer tensors (usually Sint8/Uint8):
+    // real = scale * (quantized - zeroPoint).
+    struct Quantization
+    {
+        // Per tensor if axis < 0 (one scale and zero point),
+        // otherwise per channel along the axis (one per index of the dimension).
+        int32_t axis = -1;
+        std::vector<float> scales;
+        std::vector<int32_t> zeroPoints;
+    };
+    Quantization m_quantization;
+    bool IsQuantized() const { return !m_quantization.scales.empty(); }
+    void SetQuantization(float scale, int32_t zeroPoint);
+    void SetQuantization(int32_t axis, rad::Span<float> scales, rad::Span<int32_t> zeroPoints);
+
     // Different tensors may share the same storage, with different views.
     rad::Ref<Buffer> m_buffer;
     VkDeviceSize m_bufferOffset = 0;
@@ -81,11 +102,38 @@ public:
     static VkDeviceSize CalculateBufferSize(DataType dataType,
         rad::Span<uint64_t> sizes, rad::Span<uint64_t> strides);
     bool CreateBuffer(VkDeviceSize size);
+    VkDescriptorBufferInfo GetDescriptorInfo() const;
+    // The device address of the first element (at m_bufferOffset), 0 if not supported.
+    VkDeviceAddress GetDeviceAddress() const;
+
+    // Residency (see ResidencyManager), for tensors that do not share their storage:
+    // Evict demotes the buffer to host memory, where kernels can still access it (slower),
+    // and Restore copies it back to device local memory. Both replace m_buffer: descriptors of the old
+    // buffer become invalid, and the tensor must not be in use by the device.
+    VkDeviceSize GetResidentSize() const override;
+    bool Evict() override;
+    bool Restore() override;
 
     static rad::Ref<Tensor> CreateTensor(rad::Ref<Context> context,
         DataType dataType, rad::Span<uint64_t> sizes, rad::Span<uint64_t> strides = {});
 
+    // Sparse storage (Device::IsSparseBufferSupported), for tensors such as large embedding tables of which
+    // only a small fraction is accessed: the size can far exceed the memory committed.
+    // Pages are committed on first write through the context (WriteBuffer, WriteBufferStreamed, Fill),
+    // or by Prefetch before kernels access the range: kernel writes to pages not committed are discarded.
+    // Return nullptr if sparse buffers are not supported.
+    static rad::Ref<Tensor> CreateSparseTensor(rad::Ref<Context> context,
+        DataType dataType, rad::Span<uint64_t> sizes, rad::Span<uint64_t> strides = {});
+    bool CreateSparseBuffer(VkDeviceSize size);
+    bool IsSparse() const { return m_buffer && m_buffer->IsSparse(); }
+    // Commit the memory of the byte range [offset, offset + size) of the tensor (from m_bufferOffset).
+    bool Prefetch(VkDeviceSize offset, VkDeviceSize size);
+    bool Prefetch();
+
+    // Fill the whole buffer on the device (vkCmdFillBuffer) if the element pattern fits in 32 bits,
+    // otherwise stream the pattern from the host.
     void FillFloat16(uint16_t value);
+    void FillBFloat16(uint16_t value);
     void Fill(float value);
     void Fill(double value);
     void Fill(int64_t value);
@@ -107,8 +155,19 @@ public:
         Readable,
         Hex,
     };
+    // Dump the window [dumpOffsets, dumpOffsets + dumpSizes) of any rank: the last two dimensions
+    // are printed as rows and columns, one slice per index of the outer dimensions.
+    // Only the byte range covered by the window is read back.
     std::string Dump(DumpFormat format, rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes);
     std::string Dump(DumpFormat format);
+    void Dump(std::ostream& stream, DumpFormat format,
+        rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes);
+    void Dump(std::ostream& stream, DumpFormat format);
+
+private:
+    void FillPattern(const void* pattern, size_t patternSize);
+    void Dump(std::ostream* stream, std::string& buffer, DumpFormat format,
+        rad::Span<uint64_t> dumpOffsets, rad::Span<uint64_t> dumpSizes);
 
 }; // class Tensor
 
@@ -0,0 +1,803 @@
+#include <vkpp/Compute/TensorArchive.h>
+#include <rad/IO/File.h>
+
+#include <array>
+#include <charconv>
+
+namespace vkpp
+{
+
+namespace
+{
+
+constexpr char ArchiveMagic[8] = { 'V', 'K', 'P', 'P', 'T', 'N', 'S', 'R' };
+constexpr uint32_t ArchiveFlagChecksums = 0x1;
+constexpr uint64_t ArchiveHeaderSize = 40;
+
+constexpr std::array<uint32_t, 256> MakeCRC32Table()
+{
+    std::array<uint32_t, 256> table = {};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> g_crc32Table = MakeCRC32Table();
+
+// Sequential reader over the mapped file with bounds checking.
+struct ByteReader
+{
+    const uint8_t* data;
+    uint64_t size;
+    uint64_t offset;
+
+    bool Read(void* dest, uint64_t bytes)
+    {
+        if (bytes > size - offset)
+        {
+            return false;
+        }
+        memcpy(dest, data + offset, bytes);
+        offset += bytes;
+        return true;
+    }
+};
+
+// Just enough JSON to parse safetensors headers.
+struct JsonReader
+{
+    const char* cur;
+    const char* end;
+
+    void SkipWhitespace()
+    {
+        while ((cur < end) && ((*cur == ' ') || (*cur == '\t') || (*cur == '\n') || (*cur == '\r')))
+        {
+            ++cur;
+        }
+    }
+
+    bool Peek(char c)
+    {
+        SkipWhitespace();
+        return (cur < end) && (*cur == c);
+    }
+
+    bool Consume(char c)
+    {
+        if (Peek(c))
+        {
+            ++cur;
+            return true;
+        }
+        return false;
+    }
+
+    bool ParseString(std::string& str)
+    {
+        str.clear();
+        if (!Consume('"'))
+        {
+            return false;
+        }
+        while (cur < end)
+        {
+            char c = *cur++;
+            if (c == '"')
+            {
+                return true;
+            }
+            if (c != '\\')
+            {
+                str.push_back(c);
+                continue;
+            }
+            if (cur >= end)
+            {
+                return false;
+            }
+            char escaped = *cur++;
+            switch (escaped)
+            {
+            case '"': str.push_back('"'); break;
+            case '\\': str.push_back('\\'); break;
+            case '/': str.push_back('/'); break;
+            case 'b': str.push_back('\b'); break;
+            case 'f': str.push_back('\f'); break;
+            case 'n': str.push_back('\n'); break;
+            case 'r': str.push_back('\r'); break;
+            case 't': str.push_back('\t'); break;
+            case 'u':
+            {
+                if (end - cur < 4)
+                {
+                    return false;
+                }
+                uint32_t codePoint = 0;
+                auto result = std::from_chars(cur, cur + 4, codePoint, 16);
+                if (result.ptr != cur + 4)
+                {
+                    return false;
+                }
+                cur += 4;
+                // Tensor names are expected to be ASCII.
+                str.push_back((codePoint < 0x80) ? char(codePoint) : '?');
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool ParseUint(uint64_t& value)
+    {
+        SkipWhitespace();
+        auto result = std::from_chars(cur, end, value);
+        if (result.ec != std::errc())
+        {
+            return false;
+        }
+        cur = result.ptr;
+        return true;
+    }
+
+    bool ParseUintArray(std::vector<uint64_t>& values)
+    {
+        values.clear();
+        if (!Consume('['))
+        {
+            return false;
+        }
+        if (Consume(']'))
+        {
+            return true;
+        }
+        do
+        {
+            uint64_t value = 0;
+            if (!ParseUint(value))
+            {
+                return false;
+            }
+            values.push_back(value);
+        } while (Consume(','));
+        return Consume(']');
+    }
+
+    bool SkipValue()
+    {
+        SkipWhitespace();
+        if (cur >= end)
+        {
+            return false;
+        }
+        if (*cur == '"')
+        {
+            std::string str;
+            return ParseString(str);
+        }
+        if ((*cur == '{') || (*cur == '['))
+        {
+            char close = (*cur == '{') ? '}' : ']';
+            bool isObject = (*cur == '{');
+            ++cur;
+            if (Consume(close))
+            {
+                return true;
+            }
+            do
+            {
+                if (isObject)
+                {
+                    std::string key;
+                    if (!ParseString(key) || !Consume(':'))
+                    {
+                        return false;
+                    }
+                }
+                if (!SkipValue())
+                {
+                    return false;
+                }
+            } while (Consume(','));
+            return Consume(close);
+        }
+        // Number, true, false or null.
+        const char* begin = cur;
+        while ((cur < end) && (*cur != ',') && (*cur != '}') && (*cur != ']') &&
+            (*cur != ' ') && (*cur != '\t') && (*cur != '\n') && (*cur != '\r'))
+        {
+            ++cur;
+        }
+        return (cur > begin);
+    }
+};
+
+Tensor::DataType GetDataTypeFromSafetensors(std::string_view dtype)
+{
+    if (dtype == "F16") return Tensor::DataType::Float16;
+    if (dtype == "F32") return Tensor::DataType::Float32;
+    if (dtype == "F64") return Tensor::DataType::Float64;
+    if (dtype == "BF16") return Tensor::DataType::BFloat16;
+    if (dtype == "I8") return Tensor::DataType::Sint8;
+    if (dtype == "I16") return Tensor::DataType::Sint16;
+    if (dtype == "I32") return Tensor::DataType::Sint32;
+    if (dtype == "I64") return Tensor::DataType::Sint64;
+    if (dtype == "U8") return Tensor::DataType::Uint8;
+    if (dtype == "BOOL") return Tensor::DataType::Uint8;
+    if (dtype == "U16") return Tensor::DataType::Uint16;
+    if (dtype == "U32") return Tensor::DataType::Uint32;
+    if (dtype == "U64") return Tensor::DataType::Uint64;
+    return Tensor::DataType::Undefined;
+}
+
+} // namespace
+
+uint32_t TensorArchive::ComputeCRC32(const void* data, size_t size, uint32_t crc)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = g_crc32Table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+TensorArchive::TensorArchive(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+TensorArchive::~TensorArchive()
+{
+    Close();
+}
+
+bool TensorArchive::Open(std::string_view fileName)
+{
+    Close();
+    if (!m_file.Open(fileName))
+    {
+        return false;
+    }
+
+    bool isParsed = false;
+    if ((m_file.GetSize() >= sizeof(ArchiveMagic)) &&
+        (memcmp(m_file.GetData(), ArchiveMagic, sizeof(ArchiveMagic)) == 0))
+    {
+        isParsed = ParseIndex();
+    }
+    else
+    {
+        isParsed = ParseSafetensorsIndex();
+    }
+
+    if (!isParsed)
+    {
+        VKPP_LOG(err, "TensorArchive: invalid or corrupted index: {}", fileName);
+        Close();
+        return false;
+    }
+
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        m_entryIndexMap[m_entries[i].name] = i;
+    }
+    return true;
+}
+
+void TensorArchive::Close()
+{
+    m_file.Close();
+    m_hasChecksums = false;
+    m_entries.clear();
+    m_entryIndexMap.clear();
+    m_metadata.clear();
+}
+
+bool TensorArchive::ParseIndex()
+{
+    ByteReader reader = { m_file.GetData(), m_file.GetSize(), sizeof(ArchiveMagic) };
+    uint32_t version = 0;
+    uint32_t flags = 0;
+    uint64_t tensorCount = 0;
+    uint64_t indexSize = 0;
+    uint64_t checksumOffset = 0;
+    if (!reader.Read(&version, sizeof(version)) ||
+        !reader.Read(&flags, sizeof(flags)) ||
+        !reader.Read(&tensorCount, sizeof(tensorCount)) ||
+        !reader.Read(&indexSize, sizeof(indexSize)) ||
+        !reader.Read(&checksumOffset, sizeof(checksumOffset)))
+    {
+        return false;
+    }
+
+    if ((version != Version) || (indexSize > reader.size - reader.offset))
+    {
+        return false;
+    }
+    // Payloads follow the index.
+    const uint64_t indexEnd = reader.offset + indexSize;
+
+    // Each entry takes at least 32 bytes.
+    if (tensorCount > indexSize / 32)
+    {
+        return false;
+    }
+
+    m_entries.resize(tensorCount);
+    for (Entry& entry : m_entries)
+    {
+        uint32_t nameLength = 0;
+        if (!reader.Read(&nameLength, sizeof(nameLength)) ||
+            (nameLength > reader.size - reader.offset))
+        {
+            return false;
+        }
+        entry.name.resize(nameLength);
+        reader.Read(entry.name.data(), nameLength);
+
+        uint32_t numDimensions = 0;
+        if (!reader.Read(&entry.dataType, sizeof(entry.dataType)) ||
+            !reader.Read(&numDimensions, sizeof(numDimensions)) ||
+            (entry.dataType == Tensor::DataType::Undefined) ||
+            (entry.dataType > Tensor::DataType::BFloat16) ||
+            (numDimensions == 0) ||
+            (uint64_t(numDimensions) * sizeof(uint64_t) * 2 > reader.size - reader.offset))
+        {
+            return false;
+        }
+        entry.sizes.resize(numDimensions);
+        entry.strides.resize(numDimensions);
+        reader.Read(entry.sizes.data(), numDimensions * sizeof(uint64_t));
+        reader.Read(entry.strides.data(), numDimensions * sizeof(uint64_t));
+        if (!reader.Read(&entry.dataOffset, sizeof(entry.dataOffset)) ||
+            !reader.Read(&entry.dataSize, sizeof(entry.dataSize)) ||
+            (entry.dataOffset < indexEnd) ||
+            (entry.dataOffset % PayloadAlignment != 0) ||
+            (entry.dataOffset > m_file.GetSize()) ||
+            (entry.dataSize > m_file.GetSize() - entry.dataOffset) ||
+            (entry.dataSize != Tensor::CalculateBufferSize(entry.dataType, entry.sizes, entry.strides)))
+        {
+            return false;
+        }
+    }
+
+    if (rad::HasBits(flags, ArchiveFlagChecksums))
+    {
+        if ((checksumOffset > m_file.GetSize()) ||
+            (tensorCount * sizeof(uint32_t) > m_file.GetSize() - checksumOffset))
+        {
+            return false;
+        }
+        const uint8_t* checksums = m_file.GetData() + checksumOffset;
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            memcpy(&m_entries[i].checksum, checksums + i * sizeof(uint32_t), sizeof(uint32_t));
+        }
+        m_hasChecksums = true;
+    }
+    return true;
+}
+
+bool TensorArchive::ParseSafetensorsIndex()
+{
+    uint64_t headerSize = 0;
+    ByteReader reader = { m_file.GetData(), m_file.GetSize(), 0 };
+    if (!reader.Read(&headerSize, sizeof(headerSize)) ||
+        (headerSize > reader.size - reader.offset))
+    {
+        return false;
+    }
+    const uint64_t dataBegin = sizeof(headerSize) + headerSize;
+    const uint64_t dataSize = m_file.GetSize() - dataBegin;
+
+    const char* header = reinterpret_cast<const char*>(m_file.GetData() + sizeof(headerSize));
+    JsonReader json = { header, header + headerSize };
+    if (!json.Consume('{'))
+    {
+        return false;
+    }
+    if (json.Consume('}'))
+    {
+        return true;
+    }
+
+    std::string name;
+    std::string key;
+    do
+    {
+        if (!json.ParseString(name) || !json.Consume(':') || !json.Consume('{'))
+        {
+            return false;
+        }
+
+        if (name == "__metadata__")
+        {
+            if (!json.Consume('}'))
+            {
+                do
+                {
+                    std::string value;
+                    if (!json.ParseString(key) || !json.Consume(':'))
+                    {
+                        return false;
+                    }
+                    if (json.Peek('"'))
+                    {
+                        if (!json.ParseString(value))
+                        {
+                            return false;
+                        }
+                        m_metadata[key] = std::move(value);
+                    }
+                    else if (!json.SkipValue())
+                    {
+                        return false;
+                    }
+                } while (json.Consume(','));
+                if (!json.Consume('}'))
+                {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        Entry entry;
+        entry.name = name;
+        std::string dtype;
+        std::vector<uint64_t> dataOffsets;
+        if (!json.Consume('}'))
+        {
+            do
+            {
+                if (!json.ParseString(key) || !json.Consume(':'))
+                {
+                    return false;
+                }
+                bool isValid = true;
+                if (key == "dtype")
+                {
+                    isValid = json.ParseString(dtype);
+                }
+                else if (key == "shape")
+                {
+                    isValid = json.ParseUintArray(entry.sizes);
+                }
+                else if (key == "data_offsets")
+                {
+                    isValid = json.ParseUintArray(dataOffsets);
+                }
+                else
+                {
+                    isValid = json.SkipValue();
+                }
+                if (!isValid)
+                {
+                    return false;
+                }
+            } while (json.Consume(','));
+            if (!json.Consume('}'))
+            {
+                return false;
+            }
+        }
+
+        if ((dataOffsets.size() != 2) || (dataOffsets[0] > dataOffsets[1]) ||
+            (dataOffsets[1] > dataSize))
+        {
+            return false;
+        }
+
+        entry.dataType = GetDataTypeFromSafetensors(dtype);
+        if (entry.dataType == Tensor::DataType::Undefined)
+        {
+            VKPP_LOG(warn, "TensorArchive: skip tensor \"{}\" with unsupported dtype {}.",
+                entry.name, dtype);
+            continue;
+        }
+        if (entry.sizes.empty())
+        {
+            // Scalar.
+            entry.sizes.push_back(1);
+        }
+        entry.strides = Tensor::GetDefaultStrides(entry.sizes);
+        entry.dataOffset = dataBegin + dataOffsets[0];
+        entry.dataSize = dataOffsets[1] - dataOffsets[0];
+        if (entry.dataSize != Tensor::GetElementCount(entry.sizes) *
+            Tensor::GetElementSizeInBytes(entry.dataType))
+        {
+            return false;
+        }
+        m_entries.push_back(std::move(entry));
+    } while (json.Consume(','));
+
+    return json.Consume('}');
+}
+
+const TensorArchive::Entry* TensorArchive::FindEntry(std::string_view name) const
+{
+    auto iter = m_entryIndexMap.find(name);
+    if (iter != m_entryIndexMap.end())
+    {
+        return &m_entries[iter->second];
+    }
+    return nullptr;
+}
+
+bool TensorArchive::VerifyChecksum(const Entry& entry) const
+{
+    if (!m_hasChecksums)
+    {
+        return true;
+    }
+    uint32_t checksum = ComputeCRC32(m_file.GetData() + entry.dataOffset, entry.dataSize);
+    if (checksum != entry.checksum)
+    {
+        VKPP_LOG(err, "TensorArchive: checksum mismatch for tensor \"{}\".", entry.name);
+        return false;
+    }
+    return true;
+}
+
+rad::Ref<Tensor> TensorArchive::CreateTensor(const Entry& entry)
+{
+    return Tensor::CreateTensor(m_context, entry.dataType, entry.sizes, entry.strides);
+}
+
+rad::Ref<Tensor> TensorArchive::LoadTensor(std::string_view name, bool verifyChecksum)
+{
+    const Entry* entry = FindEntry(name);
+    if (!entry)
+    {
+        VKPP_LOG(err, "TensorArchive: tensor \"{}\" not found.", name);
+        return nullptr;
+    }
+    if (verifyChecksum && !VerifyChecksum(*entry))
+    {
+        return nullptr;
+    }
+
+    rad::Ref<Tensor> tensor = CreateTensor(*entry);
+    const uint8_t* payload = m_file.GetData() + entry->dataOffset;
+    m_context->WriteBufferStreamed(tensor->m_buffer.get(), tensor->m_bufferOffset, entry->dataSize,
+        [&](void* dest, VkDeviceSize offset, VkDeviceSize size)
+        {
+            memcpy(dest, payload + offset, size);
+        });
+    return tensor;
+}
+
+std::vector<rad::Ref<Tensor>> TensorArchive::LoadTensors(
+    rad::Span<std::string_view> names, bool verifyChecksum)
+{
+    std::vector<rad::Ref<Tensor>> tensors(names.size());
+    std::vector<const Entry*> entries(names.size(), nullptr);
+
+    // Payloads larger than this are streamed on their own.
+    const VkDeviceSize packLimit = Context::DefaultStreamChunkSize / 4;
+    VkDeviceSize packedSize = 0;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        entries[i] = FindEntry(names[i]);
+        if (!entries[i])
+        {
+            VKPP_LOG(err, "TensorArchive: tensor \"{}\" not found.", names[i]);
+            continue;
+        }
+        if (verifyChecksum && !VerifyChecksum(*entries[i]))
+        {
+            entries[i] = nullptr;
+            continue;
+        }
+        if (entries[i]->dataSize <= packLimit)
+        {
+            packedSize += entries[i]->dataSize;
+        }
+    }
+
+    const VkDeviceSize stagingSize = std::min(packedSize, Context::DefaultStreamChunkSize);
+    Device* device = m_context->GetDevice();
+    QueueFamily queueFamily = QueueFamilyUniversal;
+    Queue* queue = m_context->GetQueue(queueFamily);
+
+    struct PendingCopy
+    {
+        Buffer* buffer;
+        VkBufferCopy region;
+    };
+    std::vector<PendingCopy> pendingCopies;
+    rad::Ref<Buffer> stagingBuffers[2];
+    rad::Ref<Fence> fences[2];
+    rad::Ref<CommandBuffer> cmdBuffers[2];
+    uint32_t slot = 0;
+    VkDeviceSize stagingOffset = 0;
+    if (stagingSize > 0)
+    {
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            stagingBuffers[i] = device->CreateStagingBuffer(stagingSize, true);
+            fences[i] = device->CreateFence();
+        }
+    }
+
+    // Submit the copies packed in the current staging buffer, then switch to the other one.
+    auto submitPending = [&]()
+    {
+        if (pendingCopies.empty())
+        {
+            return;
+        }
+        Buffer* stagingBuffer = stagingBuffers[slot].get();
+        if (!stagingBuffer->IsHostCoherent())
+        {
+            stagingBuffer->FlushAllocation(0, stagingOffset);
+        }
+        cmdBuffers[slot] = m_context->AllocateTransientCommandBuffer(queueFamily);
+        CommandBuffer* cmdBuffer = cmdBuffers[slot].get();
+        cmdBuffer->Begin();
+        for (const PendingCopy& copy : pendingCopies)
+        {
+            cmdBuffer->CopyBuffer(stagingBuffer, copy.buffer, copy.region);
+        }
+        cmdBuffer->End();
+        queue->Submit(cmdBuffer, {}, {}, fences[slot].get());
+        pendingCopies.clear();
+        stagingOffset = 0;
+
+        slot = 1 - slot;
+        if (cmdBuffers[slot])
+        {
+            fences[slot]->Wait();
+            fences[slot]->Reset();
+            cmdBuffers[slot].reset();
+        }
+    };
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const Entry* entry = entries[i];
+        if (!entry)
+        {
+            continue;
+        }
+        tensors[i] = CreateTensor(*entry);
+        Tensor* tensor = tensors[i].get();
+        const uint8_t* payload = m_file.GetData() + entry->dataOffset;
+        if (entry->dataSize > packLimit)
+        {
+            m_context->WriteBufferStreamed(tensor->m_buffer.get(), tensor->m_bufferOffset,
+                entry->dataSize,
+                [&](void* dest, VkDeviceSize offset, VkDeviceSize size)
+                {
+                    memcpy(dest, payload + offset, size);
+                });
+            continue;
+        }
+
+        if (stagingOffset + entry->dataSize > stagingSize)
+        {
+            submitPending();
+        }
+        uint8_t* stagingData = static_cast<uint8_t*>(stagingBuffers[slot]->GetMappedAddr());
+        memcpy(stagingData + stagingOffset, payload, entry->dataSize);
+        PendingCopy copy = {};
+        copy.buffer = tensor->m_buffer.get();
+        copy.region.srcOffset = stagingOffset;
+        copy.region.dstOffset = tensor->m_bufferOffset;
+        copy.region.size = entry->dataSize;
+        if (copy.region.size > 0)
+        {
+            pendingCopies.push_back(copy);
+        }
+        stagingOffset += entry->dataSize;
+    }
+    submitPending();
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        if (cmdBuffers[i])
+        {
+            fences[i]->Wait();
+        }
+    }
+    return tensors;
+}
+
+bool TensorArchive::Save(std::string_view fileName,
+    rad::Span<std::string_view> names, rad::Span<Tensor*> tensors, bool writeChecksums)
+{
+    assert(names.size() == tensors.size());
+    if (names.size() != tensors.size())
+    {
+        return false;
+    }
+
+    uint64_t indexSize = 0;
+    for (size_t i = 0; i < tensors.size(); ++i)
+    {
+        indexSize += sizeof(uint32_t) + names[i].size() + sizeof(uint32_t) * 2 +
+            tensors[i]->GetNumDimensions() * sizeof(uint64_t) * 2 + sizeof(uint64_t) * 2;
+    }
+
+    std::vector<uint64_t> dataOffsets(tensors.size());
+    uint64_t dataEnd = rad::RoundUpToMultiple<uint64_t>(ArchiveHeaderSize + indexSize, PayloadAlignment);
+    for (size_t i = 0; i < tensors.size(); ++i)
+    {
+        dataOffsets[i] = rad::RoundUpToMultiple<uint64_t>(dataEnd, PayloadAlignment);
+        dataEnd = dataOffsets[i] + tensors[i]->m_bufferSize;
+    }
+
+    rad::File file;
+    if (!file.Open(fileName, "wb"))
+    {
+        return false;
+    }
+
+    uint32_t flags = writeChecksums ? ArchiveFlagChecksums : 0;
+    uint64_t tensorCount = tensors.size();
+    uint64_t checksumOffset = writeChecksums ? dataEnd : 0;
+    file.Write(ArchiveMagic, sizeof(ArchiveMagic));
+    file.Write(&Version, sizeof(Version));
+    file.Write(&flags, sizeof(flags));
+    file.Write(&tensorCount, sizeof(tensorCount));
+    file.Write(&indexSize, sizeof(indexSize));
+    file.Write(&checksumOffset, sizeof(checksumOffset));
+
+    for (size_t i = 0; i < tensors.size(); ++i)
+    {
+        const Tensor* tensor = tensors[i];
+        uint32_t nameLength = static_cast<uint32_t>(names[i].size());
+        file.Write(&nameLength, sizeof(nameLength));
+        file.Write(names[i].data(), nameLength);
+        file.Write(&tensor->m_dataType, sizeof(tensor->m_dataType));
+        uint32_t numDimensions = static_cast<uint32_t>(tensor->m_sizes.size());
+        file.Write(&numDimensions, sizeof(numDimensions));
+        file.Write(tensor->m_sizes.data(), sizeof(uint64_t), tensor->m_sizes.size());
+        file.Write(tensor->m_strides.data(), sizeof(uint64_t), tensor->m_strides.size());
+        file.Write(&dataOffsets[i], sizeof(dataOffsets[i]));
+        file.Write(&tensor->m_bufferSize, sizeof(tensor->m_bufferSize));
+    }
+
+    static const uint8_t zeros[PayloadAlignment] = {};
+    uint64_t fileOffset = ArchiveHeaderSize + indexSize;
+    std::vector<uint32_t> checksums(tensors.size(), 0);
+    for (size_t i = 0; i < tensors.size(); ++i)
+    {
+        Tensor* tensor = tensors[i];
+        file.Write(zeros, dataOffsets[i] - fileOffset);
+        uint32_t crc = 0;
+        tensor->m_context->ReadBufferStreamed(tensor->m_buffer.get(),
+            tensor->m_bufferOffset, tensor->m_bufferSize,
+            [&](const void* src, VkDeviceSize offset, VkDeviceSize size)
+            {
+                file.Write(src, size);
+                if (writeChecksums)
+                {
+                    crc = ComputeCRC32(src, size, crc);
+                }
+            });
+        checksums[i] = crc;
+        fileOffset = dataOffsets[i] + tensor->m_bufferSize;
+    }
+
+    if (writeChecksums)
+    {
+        file.Write(checksums.data(), sizeof(uint32_t), checksums.size());
+    }
+    file.Close();
+    return true;
+}
+
+} // namespace vkpp
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vkpp/Compute/Tensor.h>
+#include <vkpp/Core/MappedFile.h>
+#include <map>
+
+namespace vkpp
+{
+
+// Container of named tensors, in binary format:
+// char magic[8] = "VKPPTNSR";
+// uint32 version;
+// uint32 flags;
+// uint64 tensorCount;
+// uint64 indexSizeInBytes;
+// uint64 checksumOffset;   // 0 if no checksum table.
+// Entry index[tensorCount]:
+//     uint32 nameLength; char name[nameLength];
+//     uint32 dataType; uint32 numDimensions;
+//     uint64 sizes[numDimensions]; uint64 strides[numDimensions];
+//     uint64 dataOffset;   // from the beginning of the file, aligned to PayloadAlignment.
+//     uint64 dataSizeInBytes;
+// byte payloads[];
+// uint32 checksums[tensorCount]; // CRC32 of each payload, at checksumOffset.
+// Safetensors files (*.safetensors) can be opened as well (read only).
+class TensorArchive : public rad::RefCounted<TensorArchive>
+{
+public:
+    static constexpr uint32_t Version = 1;
+    static constexpr uint64_t PayloadAlignment = 4096;
+
+    struct Entry
+    {
+        std::string name;
+        Tensor::DataType dataType = Tensor::DataType::Undefined;
+        std::vector<uint64_t> sizes;
+        std::vector<uint64_t> strides;
+        uint64_t dataOffset = 0;
+        uint64_t dataSize = 0;
+        uint32_t checksum = 0;
+    };
+
+    TensorArchive(rad::Ref<Context> context);
+    ~TensorArchive();
+    VKPP_DISABLE_COPY_AND_MOVE(TensorArchive);
+
+    // Map the file and parse the index only; payloads are loaded on demand.
+    bool Open(std::string_view fileName);
+    void Close();
+
+    bool HasChecksums() const { return m_hasChecksums; }
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+    const Entry* FindEntry(std::string_view name) const;
+    // Metadata of safetensors files (__metadata__).
+    const std::map<std::string, std::string, rad::StringLess>& GetMetadata() const { return m_metadata; }
+
+    bool VerifyChecksum(const Entry& entry) const;
+
+    rad::Ref<Tensor> LoadTensor(std::string_view name, bool verifyChecksum = false);
+    // Upload many tensors at once: small payloads are packed into shared staging buffers
+    // and copied with few submissions, large payloads are streamed in chunks.
+    // Returns null for tensors not found (or failed verification).
+    std::vector<rad::Ref<Tensor>> LoadTensors(
+        rad::Span<std::string_view> names, bool verifyChecksum = false);
+
+    static bool Save(std::string_view fileName,
+        rad::Span<std::string_view> names, rad::Span<Tensor*> tensors, bool writeChecksums = true);
+
+    static uint32_t ComputeCRC32(const void* data, size_t size, uint32_t crc = 0);
+
+private:
+    bool ParseIndex();
+    bool ParseSafetensorsIndex();
+    rad::Ref<Tensor> CreateTensor(const Entry& entry);
+
+    rad::Ref<Context> m_context;
+    MappedFile m_file;
+    bool m_hasChecksums = false;
+    std::vector<Entry> m_entries;
+    std::map<std::string, size_t, rad::StringLess> m_entryIndexMap;
+    std::map<std::string, std::string, rad::StringLess> m_metadata;
+
+}; // class TensorArchive
+
+} // namespace vkpp
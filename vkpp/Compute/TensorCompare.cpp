@@ -0,0 +1,146 @@
+#include <vkpp/Compute/TensorCompare.h>
+
+#include <cstddef>
+
+namespace vkpp
+{
+
+TensorCompare::TensorCompare(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+TensorCompare::~TensorCompare()
+{
+}
+
+ComputeKernel* TensorCompare::GetKernel(Tensor::DataType dataType)
+{
+    auto iter = m_kernels.find(dataType);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetPushDescriptorArguments();
+    if (!kernel->Init("Compute/TensorCompare.comp", macros, 3, sizeof(PushConstants)))
+    {
+        return nullptr;
+    }
+    m_kernels[dataType] = kernel;
+    return kernel.get();
+}
+
+TensorCompare::Result TensorCompare::Run(Tensor* result, Tensor* reference, float atol, float rtol)
+{
+    Result summary = {};
+    assert(result->m_dataType == reference->m_dataType);
+    assert(result->m_sizes == reference->m_sizes);
+    if ((result->m_dataType != reference->m_dataType) || (result->m_sizes != reference->m_sizes))
+    {
+        VKPP_LOG(err, "TensorCompare: data type or sizes mismatch!");
+        summary.mismatchCount = result->GetElementCount();
+        return summary;
+    }
+
+    PushConstants pushConstants = {};
+    uint32_t sizesB[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(result, pushConstants.sizes, pushConstants.stridesA) ||
+        !ComputeKernel::GetTensorShape(reference, sizesB, pushConstants.stridesB))
+    {
+        VKPP_LOG(err, "TensorCompare: tensor shape is not supported!");
+        summary.mismatchCount = result->GetElementCount();
+        return summary;
+    }
+    pushConstants.numDims = static_cast<uint32_t>(result->GetNumDimensions());
+    pushConstants.elementCount = static_cast<uint32_t>(result->GetElementCount());
+    pushConstants.atol = atol;
+    pushConstants.rtol = rtol;
+    pushConstants.maxMismatchIndices = MaxMismatchIndices;
+
+    ComputeKernel* kernel = GetKernel(result->m_dataType);
+    if (!kernel)
+    {
+        summary.mismatchCount = result->GetElementCount();
+        return summary;
+    }
+
+    Device* device = m_context->GetDevice();
+    if (!m_resultBuffer)
+    {
+        // Host visible, read back without staging.
+        m_resultBuffer = device->CreateBuffer(sizeof(ResultData),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VMA_MEMORY_USAGE_GPU_TO_CPU);
+    }
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    cmdBuffer->FillBuffer(m_resultBuffer.get(), 0, offsetof(ResultData, mismatchIndices), 0);
+    cmdBuffer->FillBuffer(m_resultBuffer.get(), offsetof(ResultData, mismatchIndices),
+        sizeof(ResultData::mismatchIndices), UINT32_MAX);
+
+    VkMemoryBarrier clearBarrier = {};
+    clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    clearBarrier.pNext = nullptr;
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        clearBarrier, {}, {});
+
+    rad::Ref<DescriptorSet> descSet;
+    if (!kernel->DispatchWithBuffers(cmdBuffer.get(),
+        {
+            result->GetDescriptorInfo(),
+            reference->GetDescriptorInfo(),
+            m_resultBuffer->GetDescriptorInfo(),
+        },
+        &pushConstants, descSet, kernel->GetGroupCount(pushConstants.elementCount)))
+    {
+        cmdBuffer->End();
+        summary.mismatchCount = result->GetElementCount();
+        return summary;
+    }
+
+    VkMemoryBarrier hostReadBarrier = {};
+    hostReadBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    hostReadBarrier.pNext = nullptr;
+    hostReadBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    hostReadBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    cmdBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        hostReadBarrier, {}, {});
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+
+    ResultData data = {};
+    m_context->ReadBuffer(m_resultBuffer.get(), &data);
+
+    float maxAbsError = 0;
+    float maxRelError = 0;
+    memcpy(&maxAbsError, &data.maxAbsError, sizeof(float));
+    memcpy(&maxRelError, &data.maxRelError, sizeof(float));
+    summary.maxAbsError = maxAbsError;
+    summary.maxRelError = maxRelError;
+    summary.maxUlpDistance = data.maxUlpDistance;
+    summary.mismatchCount = data.mismatchCount;
+    for (uint32_t index : data.mismatchIndices)
+    {
+        if (index == UINT32_MAX)
+        {
+            break;
+        }
+        summary.mismatchIndices.push_back(index);
+    }
+    return summary;
+}
+
+} // namespace vkpp
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+
+namespace vkpp
+{
+
+// Compare tensors on the device; only a small summary is read back.
+class TensorCompare : public rad::RefCounted<TensorCompare>
+{
+public:
+    static constexpr uint32_t MaxMismatchIndices = 64;
+
+    struct Result
+    {
+        double maxAbsError = 0;
+        // |a - b| / |b|
+        double maxRelError = 0;
+        // Max ULP distance, for Float16, BFloat16 and Float32 only.
+        uint32_t maxUlpDistance = 0;
+        // Elements with |a - b| > atol + rtol * |b|; NaNs only match NaNs.
+        uint64_t mismatchCount = 0;
+        // Logical (row major) indices of the first mismatches in ascending order, up to MaxMismatchIndices.
+        std::vector<uint64_t> mismatchIndices;
+
+        bool IsMatch() const { return (mismatchCount == 0); }
+    };
+
+    TensorCompare(rad::Ref<Context> context);
+    ~TensorCompare();
+    VKPP_DISABLE_COPY_AND_MOVE(TensorCompare);
+
+    // Compare result with reference, which must have the same data type and sizes (strides can differ).
+    Result Run(Tensor* result, Tensor* reference, float atol = 1e-5f, float rtol = 1e-3f);
+
+private:
+    ComputeKernel* GetKernel(Tensor::DataType dataType);
+
+    // Must match the result buffer in TensorCompare.comp.
+    struct ResultData
+    {
+        uint32_t maxAbsError;
+        uint32_t maxRelError;
+        uint32_t maxUlpDistance;
+        uint32_t mismatchCount;
+        uint32_t reserved[4];
+        // Ascending, UINT32_MAX for the slots not used.
+        uint32_t mismatchIndices[MaxMismatchIndices];
+    };
+
+    struct PushConstants
+    {
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t stridesA[ComputeKernel::MaxDimensions];
+        uint32_t stridesB[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t elementCount;
+        float atol;
+        float rtol;
+        uint32_t maxMismatchIndices;
+    };
+
+    rad::Ref<Context> m_context;
+    std::map<Tensor::DataType, rad::Ref<ComputeKernel>> m_kernels;
+    rad::Ref<Buffer> m_resultBuffer;
+
+}; // class TensorCompare
+
+} // namespace vkpp
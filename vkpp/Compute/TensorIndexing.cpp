@@ -0,0 +1,332 @@
+#include <vkpp/Compute/TensorIndexing.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+TensorIndexing::TensorIndexing(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+TensorIndexing::~TensorIndexing()
+{
+}
+
+bool TensorIndexing::IsIndexType(Tensor::DataType dataType)
+{
+    return (dataType == Tensor::DataType::Sint32) || (dataType == Tensor::DataType::Sint64);
+}
+
+ComputeKernel* TensorIndexing::GetGatherKernel(Tensor::DataType dataType, Tensor::DataType indexType)
+{
+    auto key = std::make_pair(dataType, indexType);
+    auto iter = m_gatherKernels.find(key);
+    if (iter != m_gatherKernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    ComputeKernel::AddDataTypeMacros(macros, "INDEX_TYPE", indexType);
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    if (!kernel->Init("Compute/Gather.comp", macros, 3, sizeof(GatherPushConstants)))
+    {
+        return nullptr;
+    }
+    m_gatherKernels[key] = kernel;
+    return kernel.get();
+}
+
+ComputeKernel* TensorIndexing::GetScatterKernel(Tensor::DataType dataType, Tensor::DataType indexType,
+    ScatterReduce reduce)
+{
+    auto key = std::make_tuple(dataType, indexType, reduce);
+    auto iter = m_scatterKernels.find(key);
+    if (iter != m_scatterKernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    ComputeKernel::AddDataTypeMacros(macros, "INDEX_TYPE", indexType);
+    macros.emplace_back("REDUCE", static_cast<uint32_t>(reduce));
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    if (!kernel->Init("Compute/Scatter.comp", macros, 4, sizeof(ScatterPushConstants)))
+    {
+        return nullptr;
+    }
+    m_scatterKernels[key] = kernel;
+    return kernel.get();
+}
+
+bool TensorIndexing::Gather(Tensor* input, uint32_t axis, Tensor* index, Tensor* output,
+    float outOfRangeValue)
+{
+    const size_t numDims = input->GetNumDimensions();
+    if ((axis >= numDims) || (index->GetNumDimensions() != numDims))
+    {
+        VKPP_LOG(err, "Gather: index must have the dimensions of the input!");
+        return false;
+    }
+    for (size_t dim = 0; dim < numDims; ++dim)
+    {
+        if ((dim != axis) && (index->m_sizes[dim] > input->m_sizes[dim]))
+        {
+            VKPP_LOG(err, "Gather: index is larger than the input along dimension {}!", dim);
+            return false;
+        }
+    }
+
+    GatherPushConstants pushConstants = {};
+    uint32_t inputSizes[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(input, inputSizes, pushConstants.inputStrides) ||
+        !ComputeKernel::GetTensorShape(index, pushConstants.sizes, pushConstants.indexStrides))
+    {
+        VKPP_LOG(err, "Gather: tensor shape is not supported!");
+        return false;
+    }
+    pushConstants.numDims = static_cast<uint32_t>(numDims);
+    pushConstants.axisSize = inputSizes[axis];
+    pushConstants.axisStride = pushConstants.inputStrides[axis];
+    pushConstants.inputStrides[axis] = 0;
+    pushConstants.outOfRangeValue = outOfRangeValue;
+    return RunGather(input, index, output, pushConstants);
+}
+
+bool TensorIndexing::TakeAlongAxis(Tensor* input, Tensor* index, uint32_t axis, Tensor* output,
+    float outOfRangeValue)
+{
+    const size_t numDims = input->GetNumDimensions();
+    if ((axis >= numDims) || (index->GetNumDimensions() != numDims))
+    {
+        VKPP_LOG(err, "TakeAlongAxis: index must have the dimensions of the input!");
+        return false;
+    }
+
+    GatherPushConstants pushConstants = {};
+    uint32_t inputSizes[ComputeKernel::MaxDimensions] = {};
+    uint32_t indexSizes[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(input, inputSizes, pushConstants.inputStrides) ||
+        !ComputeKernel::GetTensorShape(index, indexSizes, pushConstants.indexStrides))
+    {
+        VKPP_LOG(err, "TakeAlongAxis: tensor shape is not supported!");
+        return false;
+    }
+    for (size_t dim = 0; dim < numDims; ++dim)
+    {
+        if (dim == axis)
+        {
+            pushConstants.sizes[dim] = indexSizes[dim];
+            continue;
+        }
+        if ((inputSizes[dim] != indexSizes[dim]) && (inputSizes[dim] != 1) && (indexSizes[dim] != 1))
+        {
+            VKPP_LOG(err, "TakeAlongAxis: input and index cannot be broadcast along dimension {}!", dim);
+            return false;
+        }
+        pushConstants.sizes[dim] = std::max(inputSizes[dim], indexSizes[dim]);
+        if (inputSizes[dim] == 1)
+        {
+            pushConstants.inputStrides[dim] = 0;
+        }
+        if (indexSizes[dim] == 1)
+        {
+            pushConstants.indexStrides[dim] = 0;
+        }
+    }
+    pushConstants.numDims = static_cast<uint32_t>(numDims);
+    pushConstants.axisSize = inputSizes[axis];
+    pushConstants.axisStride = pushConstants.inputStrides[axis];
+    pushConstants.inputStrides[axis] = 0;
+    pushConstants.outOfRangeValue = outOfRangeValue;
+    return RunGather(input, index, output, pushConstants);
+}
+
+bool TensorIndexing::IndexSelect(Tensor* input, uint32_t axis, Tensor* index, Tensor* output,
+    float outOfRangeValue)
+{
+    const size_t numDims = input->GetNumDimensions();
+    if ((axis >= numDims) || (index->GetNumDimensions() != 1))
+    {
+        VKPP_LOG(err, "IndexSelect: index must be 1D!");
+        return false;
+    }
+
+    GatherPushConstants pushConstants = {};
+    uint32_t indexSize[ComputeKernel::MaxDimensions] = {};
+    uint32_t indexStride[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(input, pushConstants.sizes, pushConstants.inputStrides) ||
+        !ComputeKernel::GetTensorShape(index, indexSize, indexStride))
+    {
+        VKPP_LOG(err, "IndexSelect: tensor shape is not supported!");
+        return false;
+    }
+    pushConstants.numDims = static_cast<uint32_t>(numDims);
+    pushConstants.axisSize = pushConstants.sizes[axis];
+    pushConstants.axisStride = pushConstants.inputStrides[axis];
+    pushConstants.sizes[axis] = indexSize[0];
+    pushConstants.inputStrides[axis] = 0;
+    pushConstants.indexStrides[axis] = indexStride[0];
+    pushConstants.outOfRangeValue = outOfRangeValue;
+    return RunGather(input, index, output, pushConstants);
+}
+
+bool TensorIndexing::Embedding(Tensor* table, Tensor* index, Tensor* output, float outOfRangeValue)
+{
+    const size_t indexDims = index->GetNumDimensions();
+    if ((table->GetNumDimensions() != 2) || (indexDims + 1 > ComputeKernel::MaxDimensions))
+    {
+        VKPP_LOG(err, "Embedding: the table must be 2D, and index must have less than {} dimensions!",
+            ComputeKernel::MaxDimensions);
+        return false;
+    }
+
+    GatherPushConstants pushConstants = {};
+    uint32_t tableSizes[ComputeKernel::MaxDimensions] = {};
+    uint32_t tableStrides[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(table, tableSizes, tableStrides) ||
+        !ComputeKernel::GetTensorShape(index, pushConstants.sizes, pushConstants.indexStrides))
+    {
+        VKPP_LOG(err, "Embedding: tensor shape is not supported!");
+        return false;
+    }
+    // The index dimensions select rows, the last dimension is the embedding.
+    pushConstants.sizes[indexDims] = tableSizes[1];
+    pushConstants.inputStrides[indexDims] = tableStrides[1];
+    pushConstants.indexStrides[indexDims] = 0;
+    pushConstants.numDims = static_cast<uint32_t>(indexDims + 1);
+    pushConstants.axisSize = tableSizes[0];
+    pushConstants.axisStride = tableStrides[0];
+    pushConstants.outOfRangeValue = outOfRangeValue;
+    return RunGather(table, index, output, pushConstants);
+}
+
+bool TensorIndexing::RunGather(Tensor* input, Tensor* index, Tensor* output,
+    GatherPushConstants& pushConstants)
+{
+    if (!IsIndexType(index->m_dataType))
+    {
+        VKPP_LOG(err, "TensorIndexing: index must be Sint32 or Sint64!");
+        return false;
+    }
+    const bool sizesMatch = (output->GetNumDimensions() == pushConstants.numDims) &&
+        std::equal(output->m_sizes.begin(), output->m_sizes.end(), pushConstants.sizes);
+    if ((output->m_dataType != input->m_dataType) || !output->m_isContiguous || !sizesMatch ||
+        (output->GetElementCount() > UINT32_MAX))
+    {
+        VKPP_LOG(err, "TensorIndexing: output must be contiguous with the type of the input and the result sizes!");
+        return false;
+    }
+    pushConstants.elementCount = static_cast<uint32_t>(output->GetElementCount());
+    if (pushConstants.elementCount == 0)
+    {
+        return true;
+    }
+
+    ComputeKernel* kernel = GetGatherKernel(input->m_dataType, index->m_dataType);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    rad::Ref<DescriptorSet> descSet = kernel->AllocateDescriptorSet(
+        {
+            input->GetDescriptorInfo(),
+            index->GetDescriptorInfo(),
+            output->GetDescriptorInfo(),
+        });
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    if (!kernel->Dispatch(cmdBuffer.get(), descSet.get(), &pushConstants,
+        kernel->GetGroupCount(pushConstants.elementCount)))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+bool TensorIndexing::Scatter(Tensor* output, uint32_t axis, Tensor* index, Tensor* source,
+    ScatterReduce reduce)
+{
+    const size_t numDims = output->GetNumDimensions();
+    if ((axis >= numDims) || (index->GetNumDimensions() != numDims) ||
+        (source->GetNumDimensions() != numDims) || !IsIndexType(index->m_dataType) ||
+        !index->m_isContiguous || (source->m_dataType != output->m_dataType))
+    {
+        VKPP_LOG(err, "Scatter: index (Sint32/Sint64, contiguous) and source must have the dimensions of the output!");
+        return false;
+    }
+    for (size_t dim = 0; dim < numDims; ++dim)
+    {
+        if ((index->m_sizes[dim] > source->m_sizes[dim]) ||
+            ((dim != axis) && (index->m_sizes[dim] > output->m_sizes[dim])))
+        {
+            VKPP_LOG(err, "Scatter: index is larger than the source or the output along dimension {}!", dim);
+            return false;
+        }
+    }
+    const PhysicalDevice* physicalDevice = m_context->GetDevice()->GetPhysicalDevice();
+    if ((reduce != ScatterReduce::None) &&
+        (Tensor::GetElementSizeInBytes(output->m_dataType) == 8) &&
+        (physicalDevice->m_vk12Features.shaderBufferInt64Atomics != VK_TRUE))
+    {
+        VKPP_LOG(err, "Scatter: reductions of 64-bit types require shaderBufferInt64Atomics!");
+        return false;
+    }
+
+    ScatterPushConstants pushConstants = {};
+    uint32_t indexStrides[ComputeKernel::MaxDimensions] = {};
+    uint32_t sourceSizes[ComputeKernel::MaxDimensions] = {};
+    uint32_t outputSizes[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(index, pushConstants.sizes, indexStrides) ||
+        !ComputeKernel::GetTensorShape(source, sourceSizes, pushConstants.sourceStrides) ||
+        !ComputeKernel::GetTensorShape(output, outputSizes, pushConstants.outputStrides))
+    {
+        VKPP_LOG(err, "Scatter: tensor shape is not supported!");
+        return false;
+    }
+    pushConstants.numDims = static_cast<uint32_t>(numDims);
+    pushConstants.elementCount = static_cast<uint32_t>(index->GetElementCount());
+    pushConstants.axisSize = outputSizes[axis];
+    pushConstants.axisStride = pushConstants.outputStrides[axis];
+    pushConstants.outputStrides[axis] = 0;
+    if (pushConstants.elementCount == 0)
+    {
+        return true;
+    }
+
+    ComputeKernel* kernel = GetScatterKernel(output->m_dataType, index->m_dataType, reduce);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    // The output is bound again for the compare-and-swap reductions.
+    rad::Ref<DescriptorSet> descSet = kernel->AllocateDescriptorSet(
+        {
+            output->GetDescriptorInfo(),
+            index->GetDescriptorInfo(),
+            source->GetDescriptorInfo(),
+            output->GetDescriptorInfo(),
+        });
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    if (!kernel->Dispatch(cmdBuffer.get(), descSet.get(), &pushConstants,
+        kernel->GetGroupCount(pushConstants.elementCount)))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+} // namespace vkpp
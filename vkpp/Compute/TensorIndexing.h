@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+#include <tuple>
+
+namespace vkpp
+{
+
+// Index tensors by integer (Sint32/Sint64) index tensors on the device.
+// Negative indices count from the end of the axis (-1 is the last);
+// out-of-range indices produce outOfRangeValue (gather) or are ignored (scatter).
+// The operations are submitted and waited; they return false on errors.
+class TensorIndexing : public rad::RefCounted<TensorIndexing>
+{
+public:
+    enum class ScatterReduce : uint32_t
+    {
+        None,
+        Add,
+        Max,
+    };
+
+    TensorIndexing(rad::Ref<Context> context);
+    ~TensorIndexing();
+    VKPP_DISABLE_COPY_AND_MOVE(TensorIndexing);
+
+    // output[i][j][k] = input[index[i][j][k]][j][k] (axis = 0);
+    // index has the dimensions of the input, output (contiguous) has the sizes of index.
+    bool Gather(Tensor* input, uint32_t axis, Tensor* index, Tensor* output,
+        float outOfRangeValue = 0.0f);
+    // NumPy take_along_axis: Gather with the other dimensions of input and index broadcast
+    // (dimensions of size 1), output (contiguous) has the broadcast sizes.
+    bool TakeAlongAxis(Tensor* input, Tensor* index, uint32_t axis, Tensor* output,
+        float outOfRangeValue = 0.0f);
+    // output = the slices of input along axis selected by the 1D index;
+    // output (contiguous) has the sizes of input, with the index size along the axis.
+    bool IndexSelect(Tensor* input, uint32_t axis, Tensor* index, Tensor* output,
+        float outOfRangeValue = 0.0f);
+    // output[i][j][:] = table[index[i][j]][:]; table is 2D (rows of embeddings),
+    // output (contiguous) has the sizes of index plus the embedding size.
+    bool Embedding(Tensor* table, Tensor* index, Tensor* output, float outOfRangeValue = 0.0f);
+
+    // output[index[i][j][k]][j][k] (reduce)= source[i][j][k] (axis = 0), for each element of index;
+    // index (contiguous) has the dimensions of output and is not larger than source.
+    // Reductions of 64-bit types require shaderBufferInt64Atomics.
+    bool Scatter(Tensor* output, uint32_t axis, Tensor* index, Tensor* source,
+        ScatterReduce reduce = ScatterReduce::None);
+
+private:
+    // Must match Gather.comp.
+    struct GatherPushConstants
+    {
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t inputStrides[ComputeKernel::MaxDimensions];
+        uint32_t indexStrides[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t elementCount;
+        uint32_t axisSize;
+        uint32_t axisStride;
+        float outOfRangeValue;
+    };
+
+    // Must match Scatter.comp.
+    struct ScatterPushConstants
+    {
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t sourceStrides[ComputeKernel::MaxDimensions];
+        uint32_t outputStrides[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t elementCount;
+        uint32_t axisSize;
+        uint32_t axisStride;
+    };
+
+    static bool IsIndexType(Tensor::DataType dataType);
+    ComputeKernel* GetGatherKernel(Tensor::DataType dataType, Tensor::DataType indexType);
+    ComputeKernel* GetScatterKernel(Tensor::DataType dataType, Tensor::DataType indexType,
+        ScatterReduce reduce);
+    // Validate the output and dispatch; the strides of the push constants are set by the caller.
+    bool RunGather(Tensor* input, Tensor* index, Tensor* output, GatherPushConstants& pushConstants);
+
+    rad::Ref<Context> m_context;
+    std::map<std::pair<Tensor::DataType, Tensor::DataType>, rad::Ref<ComputeKernel>> m_gatherKernels;
+    std::map<std::tuple<Tensor::DataType, Tensor::DataType, ScatterReduce>,
+        rad::Ref<ComputeKernel>> m_scatterKernels;
+
+}; // class TensorIndexing
+
+} // namespace vkpp
@@ -0,0 +1,169 @@
+#include <vkpp/Compute/TensorQuantization.h>
+
+#include <limits>
+
+namespace vkpp
+{
+
+namespace
+{
+
+bool GetQuantizedRange(Tensor::DataType dataType, int32_t& minValue, int32_t& maxValue)
+{
+    switch (dataType)
+    {
+    case Tensor::DataType::Sint8:
+        minValue = std::numeric_limits<int8_t>::min();
+        maxValue = std::numeric_limits<int8_t>::max();
+        return true;
+    case Tensor::DataType::Uint8:
+        minValue = std::numeric_limits<uint8_t>::min();
+        maxValue = std::numeric_limits<uint8_t>::max();
+        return true;
+    case Tensor::DataType::Sint16:
+        minValue = std::numeric_limits<int16_t>::min();
+        maxValue = std::numeric_limits<int16_t>::max();
+        return true;
+    case Tensor::DataType::Uint16:
+        minValue = std::numeric_limits<uint16_t>::min();
+        maxValue = std::numeric_limits<uint16_t>::max();
+        return true;
+    case Tensor::DataType::Sint32:
+        minValue = std::numeric_limits<int32_t>::min();
+        maxValue = std::numeric_limits<int32_t>::max();
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TensorQuantization::TensorQuantization(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+TensorQuantization::~TensorQuantization()
+{
+}
+
+ComputeKernel* TensorQuantization::GetKernel(
+    Tensor::DataType floatType, Tensor::DataType quantType, bool quantize)
+{
+    auto key = std::make_tuple(floatType, quantType, quantize);
+    auto iter = m_kernels.find(key);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", floatType);
+    ComputeKernel::AddDataTypeMacros(macros, "QUANT_TYPE", quantType);
+    macros.emplace_back("QUANTIZE", quantize ? 1u : 0u);
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetPushDescriptorArguments();
+    if (!kernel->Init("Compute/Quantization.comp", macros, 3, sizeof(PushConstants)))
+    {
+        return nullptr;
+    }
+    m_kernels[key] = kernel;
+    return kernel.get();
+}
+
+bool TensorQuantization::Quantize(Tensor* input, Tensor* output)
+{
+    return Run(true, input, output);
+}
+
+bool TensorQuantization::Dequantize(Tensor* input, Tensor* output)
+{
+    return Run(false, output, input);
+}
+
+bool TensorQuantization::Run(bool quantize, Tensor* floatTensor, Tensor* quantTensor)
+{
+    PushConstants pushConstants = {};
+    if (!Tensor::IsFloatingPoint(floatTensor->m_dataType) ||
+        !GetQuantizedRange(quantTensor->m_dataType, pushConstants.quantMin, pushConstants.quantMax))
+    {
+        VKPP_LOG(err, "TensorQuantization: data types not supported!");
+        return false;
+    }
+    const Tensor::Quantization& quantization = quantTensor->m_quantization;
+    if ((floatTensor->m_sizes != quantTensor->m_sizes) || !quantTensor->IsQuantized() ||
+        (quantization.scales.size() != quantization.zeroPoints.size()) ||
+        ((quantization.axis >= 0) &&
+            ((size_t(quantization.axis) >= quantTensor->m_sizes.size()) ||
+            (quantization.scales.size() != quantTensor->m_sizes[quantization.axis]))))
+    {
+        VKPP_LOG(err, "TensorQuantization: sizes mismatch or invalid quantization parameters!");
+        return false;
+    }
+
+    uint32_t quantSizes[ComputeKernel::MaxDimensions] = {};
+    if (!ComputeKernel::GetTensorShape(floatTensor, pushConstants.sizes, pushConstants.floatStrides) ||
+        !ComputeKernel::GetTensorShape(quantTensor, quantSizes, pushConstants.quantStrides))
+    {
+        VKPP_LOG(err, "TensorQuantization: tensor shape is not supported!");
+        return false;
+    }
+    if (floatTensor->GetElementCount() == 0)
+    {
+        return true;
+    }
+
+    ComputeKernel* kernel = GetKernel(floatTensor->m_dataType, quantTensor->m_dataType, quantize);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    pushConstants.numDims = static_cast<uint32_t>(floatTensor->GetNumDimensions());
+    pushConstants.elementCount = static_cast<uint32_t>(floatTensor->GetElementCount());
+    pushConstants.channelCount = 1;
+    pushConstants.channelStride = 1;
+    if (quantization.axis >= 0)
+    {
+        pushConstants.channelCount = static_cast<uint32_t>(quantization.scales.size());
+        uint64_t channelStride = 1;
+        for (size_t i = size_t(quantization.axis) + 1; i < quantTensor->m_sizes.size(); ++i)
+        {
+            channelStride *= quantTensor->m_sizes[i];
+        }
+        pushConstants.channelStride = static_cast<uint32_t>(channelStride);
+    }
+
+    std::vector<ChannelParams> channelParams(quantization.scales.size());
+    for (size_t i = 0; i < channelParams.size(); ++i)
+    {
+        channelParams[i].scale = quantization.scales[i];
+        channelParams[i].zeroPoint = quantization.zeroPoints[i];
+    }
+    const VkDeviceSize paramSize = channelParams.size() * sizeof(ChannelParams);
+    if (!m_paramBuffer || (m_paramBuffer->GetSize() < paramSize))
+    {
+        m_paramBuffer = m_context->GetDevice()->CreateStorageBuffer(paramSize);
+    }
+    m_context->WriteBuffer(m_paramBuffer.get(), channelParams.data(), 0, paramSize);
+
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    rad::Ref<DescriptorSet> descSet;
+    if (!kernel->DispatchWithBuffers(cmdBuffer.get(),
+        {
+            floatTensor->GetDescriptorInfo(),
+            quantTensor->GetDescriptorInfo(),
+            m_paramBuffer->GetDescriptorInfo(),
+        },
+        &pushConstants, descSet, kernel->GetGroupCount(pushConstants.elementCount)))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+} // namespace vkpp
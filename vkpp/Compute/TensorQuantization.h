@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+#include <tuple>
+
+namespace vkpp
+{
+
+// Convert between floating point tensors and quantized integer tensors (Tensor::m_quantization),
+// per tensor or per channel: real = scale * (quantized - zeroPoint).
+// Quantized types: Sint8, Uint8, Sint16, Uint16 and Sint32. The conversions return false on errors.
+class TensorQuantization : public rad::RefCounted<TensorQuantization>
+{
+public:
+    TensorQuantization(rad::Ref<Context> context);
+    ~TensorQuantization();
+    VKPP_DISABLE_COPY_AND_MOVE(TensorQuantization);
+
+    // Round half to even and saturate; output->m_quantization must be set.
+    bool Quantize(Tensor* input, Tensor* output);
+    // input->m_quantization must be set.
+    bool Dequantize(Tensor* input, Tensor* output);
+
+private:
+    // Must match Quantization.comp.
+    struct ChannelParams
+    {
+        float scale;
+        int32_t zeroPoint;
+    };
+
+    struct PushConstants
+    {
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t floatStrides[ComputeKernel::MaxDimensions];
+        uint32_t quantStrides[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t elementCount;
+        uint32_t channelCount;
+        uint32_t channelStride;
+        int32_t quantMin;
+        int32_t quantMax;
+    };
+
+    ComputeKernel* GetKernel(Tensor::DataType floatType, Tensor::DataType quantType, bool quantize);
+    bool Run(bool quantize, Tensor* floatTensor, Tensor* quantTensor);
+
+    rad::Ref<Context> m_context;
+    std::map<std::tuple<Tensor::DataType, Tensor::DataType, bool>, rad::Ref<ComputeKernel>> m_kernels;
+    rad::Ref<Buffer> m_paramBuffer;
+
+}; // class TensorQuantization
+
+} // namespace vkpp
@@ -0,0 +1,130 @@
+#include <vkpp/Compute/TensorRandom.h>
+
+namespace vkpp
+{
+
+TensorRandom::TensorRandom(rad::Ref<Context> context) :
+    m_context(std::move(context))
+{
+}
+
+TensorRandom::~TensorRandom()
+{
+}
+
+ComputeKernel* TensorRandom::GetKernel(Tensor::DataType dataType, Distribution distribution)
+{
+    auto key = std::make_pair(dataType, distribution);
+    auto iter = m_kernels.find(key);
+    if (iter != m_kernels.end())
+    {
+        return iter->second.get();
+    }
+
+    std::vector<ShaderMacro> macros;
+    ComputeKernel::AddDataTypeMacros(macros, "DATA_TYPE", dataType);
+    macros.emplace_back("DISTRIBUTION", static_cast<uint32_t>(distribution));
+    rad::Ref<ComputeKernel> kernel = RAD_NEW ComputeKernel(m_context);
+    kernel->SetDeviceAddressArguments();
+    if (!kernel->Init("Compute/TensorRandom.comp", macros, 1, sizeof(PushConstants)))
+    {
+        return nullptr;
+    }
+    m_kernels[key] = kernel;
+    return kernel.get();
+}
+
+bool TensorRandom::FillUniform(Tensor* tensor, float minValue, float maxValue,
+    uint64_t seed, uint64_t offset)
+{
+    PushConstants pushConstants = {};
+    pushConstants.param0 = minValue;
+    pushConstants.param1 = maxValue - minValue;
+    return Run(tensor, Distribution::Uniform, pushConstants, seed, offset);
+}
+
+bool TensorRandom::FillNormal(Tensor* tensor, float mean, float stddev,
+    uint64_t seed, uint64_t offset)
+{
+    PushConstants pushConstants = {};
+    pushConstants.param0 = mean;
+    pushConstants.param1 = stddev;
+    return Run(tensor, Distribution::Normal, pushConstants, seed, offset);
+}
+
+bool TensorRandom::FillIntegers(Tensor* tensor, int64_t low, int64_t high,
+    uint64_t seed, uint64_t offset)
+{
+    assert(low <= high);
+    PushConstants pushConstants = {};
+    // Wraps to 0 for the full 64-bit range.
+    uint64_t range = uint64_t(high) - uint64_t(low) + 1;
+    if (Tensor::GetElementSizeInBytes(tensor->m_dataType) < 8)
+    {
+        assert(range <= (uint64_t(1) << 32));
+        // 0 for the full 32-bit range.
+        range = (range >= (uint64_t(1) << 32)) ? 0 : range;
+    }
+    pushConstants.intLow[0] = static_cast<uint32_t>(uint64_t(low));
+    pushConstants.intLow[1] = static_cast<uint32_t>(uint64_t(low) >> 32);
+    pushConstants.intRange[0] = static_cast<uint32_t>(range);
+    pushConstants.intRange[1] = static_cast<uint32_t>(range >> 32);
+    return Run(tensor, Distribution::Integer, pushConstants, seed, offset);
+}
+
+bool TensorRandom::Run(Tensor* tensor, Distribution distribution, PushConstants& pushConstants,
+    uint64_t seed, uint64_t offset)
+{
+    if (!ComputeKernel::GetTensorShape(tensor, pushConstants.sizes, pushConstants.strides))
+    {
+        VKPP_LOG(err, "TensorRandom: tensor shape is not supported!");
+        return false;
+    }
+    ComputeKernel* kernel = GetKernel(tensor->m_dataType, distribution);
+    if (!kernel)
+    {
+        return false;
+    }
+
+    const uint64_t elementsPerCounter = (Tensor::GetElementSizeInBytes(tensor->m_dataType) == 8) ? 2 : 4;
+    const uint64_t elementCount = tensor->GetElementCount();
+    const uint64_t firstCounter = offset / elementsPerCounter;
+    const uint64_t counterLane = offset % elementsPerCounter;
+    pushConstants.numDims = static_cast<uint32_t>(tensor->GetNumDimensions());
+    pushConstants.elementCount = static_cast<uint32_t>(elementCount);
+    pushConstants.key[0] = static_cast<uint32_t>(seed);
+    pushConstants.key[1] = static_cast<uint32_t>(seed >> 32);
+    pushConstants.firstCounter[0] = static_cast<uint32_t>(firstCounter);
+    pushConstants.firstCounter[1] = static_cast<uint32_t>(firstCounter >> 32);
+    pushConstants.counterLane = static_cast<uint32_t>(counterLane);
+    pushConstants.counterCount = static_cast<uint32_t>(
+        (counterLane + elementCount + elementsPerCounter - 1) / elementsPerCounter);
+
+    rad::Ref<DescriptorSet> descSet;
+    if (kernel->UsesDeviceAddresses())
+    {
+        pushConstants.outputData = tensor->GetDeviceAddress();
+        if (pushConstants.outputData == 0)
+        {
+            VKPP_LOG(err, "TensorRandom: the buffer has no device address!");
+            return false;
+        }
+    }
+    else
+    {
+        descSet = kernel->AllocateDescriptorSet(tensor->GetDescriptorInfo());
+    }
+    rad::Ref<CommandBuffer> cmdBuffer = m_context->AllocateTransientCommandBuffer();
+    cmdBuffer->Begin();
+    if (!kernel->Dispatch(cmdBuffer.get(), descSet.get(), &pushConstants,
+        kernel->GetGroupCount(pushConstants.counterCount)))
+    {
+        cmdBuffer->End();
+        return false;
+    }
+    cmdBuffer->End();
+    m_context->GetQueue()->SubmitAndWait(cmdBuffer.get());
+    return true;
+}
+
+} // namespace vkpp
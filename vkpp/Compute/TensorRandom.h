@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vkpp/Compute/ComputeKernel.h>
+#include <map>
+
+namespace vkpp
+{
+
+// Fill tensors with random values generated by Philox4x32-10 on the device.
+// The value of the element with logical (row major) index i is determined by
+// (seed, offset + i) only; use different offsets to continue a random stream.
+class TensorRandom : public rad::RefCounted<TensorRandom>
+{
+public:
+    enum class Distribution : uint32_t
+    {
+        Uniform,
+        Normal,
+        Integer,
+    };
+
+    TensorRandom(rad::Ref<Context> context);
+    ~TensorRandom();
+    VKPP_DISABLE_COPY_AND_MOVE(TensorRandom);
+
+    // Uniform in [minValue, maxValue).
+    bool FillUniform(Tensor* tensor, float minValue, float maxValue,
+        uint64_t seed, uint64_t offset = 0);
+    bool FillNormal(Tensor* tensor, float mean, float stddev,
+        uint64_t seed, uint64_t offset = 0);
+    // Uniform integers in [low, high].
+    bool FillIntegers(Tensor* tensor, int64_t low, int64_t high,
+        uint64_t seed, uint64_t offset = 0);
+
+private:
+    // Must match TensorRandom.comp.
+    struct PushConstants
+    {
+        VkDeviceAddress outputData; // if ComputeKernel::UsesDeviceAddresses()
+        uint32_t sizes[ComputeKernel::MaxDimensions];
+        uint32_t strides[ComputeKernel::MaxDimensions];
+        uint32_t numDims;
+        uint32_t elementCount;
+        uint32_t key[2];
+        uint32_t firstCounter[2];
+        uint32_t counterLane;
+        uint32_t counterCount;
+        float param0;
+        float param1;
+        uint32_t intLow[2];
+        uint32_t intRange[2];
+    };
+
+    ComputeKernel* GetKernel(Tensor::DataType dataType, Distribution distribution);
+    bool Run(Tensor* tensor, Distribution distribution, PushConstants& pushConstants,
+        uint64_t seed, uint64_t offset);
+
+    rad::Ref<Context> m_context;
+    std::map<std::pair<Tensor::DataType, Distribution>, rad::Ref<ComputeKernel>> m_kernels;
+
+}; // class TensorRandom
+
+} // namespace vkpp
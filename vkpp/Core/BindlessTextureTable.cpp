@@ -0,0 +1,172 @@
+#include <vkpp/Core/BindlessTextureTable.h>
+#include <vkpp/Core/PhysicalDevice.h>
+#include <vkpp/Core/Device.h>
+#include <vkpp/Core/Image.h>
+#include <vkpp/Core/Sampler.h>
+#include <vkpp/Core/Descriptor.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+BindlessTextureTable::BindlessTextureTable(rad::Ref<Device> device) :
+    m_device(std::move(device))
+{
+}
+
+BindlessTextureTable::~BindlessTextureTable()
+{
+}
+
+bool BindlessTextureTable::Init(uint32_t capacity, rad::Span<Sampler*> immutableSamplers)
+{
+    if (!m_device->IsBindlessTextureSupported())
+    {
+        VKPP_LOG(err, "BindlessTextureTable: descriptor indexing is not supported!");
+        return false;
+    }
+
+    const VkPhysicalDeviceVulkan12Properties& properties = m_device->GetPhysicalDevice()->m_vk12Properties;
+    const uint32_t maxCapacity = std::min(
+        properties.maxDescriptorSetUpdateAfterBindSampledImages,
+        properties.maxPerStageDescriptorUpdateAfterBindSampledImages);
+    if (capacity > maxCapacity)
+    {
+        VKPP_LOG(warn, "BindlessTextureTable: capacity {} is clamped to {}.", capacity, maxCapacity);
+        capacity = maxCapacity;
+    }
+    m_capacity = std::max(capacity, 1u);
+
+    rad::SmallVector<VkSampler, 8> samplerHandles;
+    samplerHandles.resize(immutableSamplers.size());
+    for (size_t i = 0; i < samplerHandles.size(); ++i)
+    {
+        samplerHandles[i] = immutableSamplers[i]->GetHandle();
+    }
+
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    bindings[0].descriptorCount = static_cast<uint32_t>(samplerHandles.size());
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+    bindings[0].pImmutableSamplers = samplerHandles.data();
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    bindings[1].descriptorCount = m_capacity;
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+    bindings[1].pImmutableSamplers = nullptr;
+
+    VkDescriptorBindingFlags bindingFlags[2] = {};
+    bindingFlags[0] = 0;
+    // Slots not accessed can be written while command buffers using the set are pending (frames in flight).
+    bindingFlags[1] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.pNext = nullptr;
+    bindingFlagsInfo.bindingCount = 2;
+    bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = 2;
+    layoutInfo.pBindings = bindings;
+    m_layout = m_device->CreateDescriptorSetLayout(layoutInfo);
+
+    rad::SmallVector<VkDescriptorPoolSize, 2> poolSizes;
+    poolSizes.push_back({ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, m_capacity });
+    if (!samplerHandles.empty())
+    {
+        poolSizes.push_back({ VK_DESCRIPTOR_TYPE_SAMPLER, static_cast<uint32_t>(samplerHandles.size()) });
+    }
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.pNext = nullptr;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    m_pool = m_device->CreateDescriptorPool(poolInfo);
+    m_descSet = m_pool->Allocate(m_layout.get());
+    if (!m_descSet)
+    {
+        VKPP_LOG(err, "BindlessTextureTable: failed to allocate the descriptor set!");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_imageViews.clear();
+    m_imageViews.resize(m_capacity);
+    m_freeSlots.clear();
+    m_slotCount = 0;
+    return true;
+}
+
+uint32_t BindlessTextureTable::Allocate(ImageView* imageView, VkImageLayout imageLayout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t slot = InvalidSlot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else if (m_slotCount < m_capacity)
+    {
+        slot = m_slotCount++;
+    }
+    else
+    {
+        VKPP_LOG(err, "BindlessTextureTable: out of slots (capacity={})!", m_capacity);
+        return InvalidSlot;
+    }
+    Write(slot, imageView, imageLayout);
+    return slot;
+}
+
+void BindlessTextureTable::Update(uint32_t slot, ImageView* imageView, VkImageLayout imageLayout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert((slot < m_slotCount) && m_imageViews[slot]);
+    Write(slot, imageView, imageLayout);
+}
+
+void BindlessTextureTable::Free(uint32_t slot)
+{
+    if (slot == InvalidSlot)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert((slot < m_slotCount) && m_imageViews[slot]);
+    // Partially bound: the stale descriptor is left in place, it is not accessed until rewritten.
+    m_imageViews[slot] = nullptr;
+    m_freeSlots.push_back(slot);
+}
+
+void BindlessTextureTable::Write(uint32_t slot, ImageView* imageView, VkImageLayout imageLayout)
+{
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler = VK_NULL_HANDLE;
+    imageInfo.imageView = imageView->GetHandle();
+    imageInfo.imageLayout = imageLayout;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.pNext = nullptr;
+    write.dstSet = m_descSet->GetHandle();
+    write.dstBinding = 1;
+    write.dstArrayElement = slot;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    write.pImageInfo = &imageInfo;
+    m_descSet->Update(write);
+    m_imageViews[slot] = imageView;
+}
+
+} // namespace vkpp
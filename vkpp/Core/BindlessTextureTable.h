@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vkpp/Core/Common.h>
+#include <mutex>
+
+namespace vkpp
+{
+
+// A global descriptor set of sampled images indexed by slot in shaders (bindless textures):
+// binding 0 holds immutable samplers, binding 1 a large array of sampled images that is partially bound
+// and updated after bind (Vulkan 1.2 descriptor indexing), declared unsized in shaders
+// (layout(binding=1) uniform texture2D g_textures[];).
+// The layout does not depend on the number of textures, so textures can stream in and out
+// without rebuilding the pipelines; slots not allocated are never accessed.
+// Thread-safe.
+class BindlessTextureTable : public rad::RefCounted<BindlessTextureTable>
+{
+public:
+    static constexpr uint32_t InvalidSlot = UINT32_MAX;
+
+    BindlessTextureTable(rad::Ref<Device> device);
+    ~BindlessTextureTable();
+    VKPP_DISABLE_COPY_AND_MOVE(BindlessTextureTable);
+
+    // @param capacity: the number of slots, clamped to maxDescriptorSetUpdateAfterBindSampledImages.
+    // Return false if the device does not support bindless textures (Device::IsBindlessTextureSupported).
+    bool Init(uint32_t capacity, rad::Span<Sampler*> immutableSamplers);
+
+    DescriptorSetLayout* GetLayout() const { return m_layout.get(); }
+    DescriptorSet* GetDescriptorSet() const { return m_descSet.get(); }
+    uint32_t GetCapacity() const { return m_capacity; }
+
+    // Allocate a slot and write the image view to it; return InvalidSlot if the table is full.
+    // The set can be bound while the slot is written.
+    uint32_t Allocate(ImageView* imageView,
+        VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // Replace the image view of a slot allocated, which must not be accessed by commands in flight.
+    void Update(uint32_t slot, ImageView* imageView,
+        VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // The slot can be reused at once: commands in flight must not access it anymore.
+    void Free(uint32_t slot);
+
+private:
+    void Write(uint32_t slot, ImageView* imageView, VkImageLayout imageLayout);
+
+    rad::Ref<Device> m_device;
+    rad::Ref<DescriptorSetLayout> m_layout;
+    rad::Ref<DescriptorPool> m_pool;
+    rad::Ref<DescriptorSet> m_descSet;
+    uint32_t m_capacity = 0;
+
+    std::mutex m_mutex;
+    // Keep the image views alive while their slots are allocated.
+    std::vector<rad::Ref<ImageView>> m_imageViews;
+    std::vector<uint32_t> m_freeSlots;
+    uint32_t m_slotCount = 0;
+
+}; // class BindlessTextureTable
+
+} // namespace vkpp
@@ -1,5 +1,6 @@
 #include <vkpp/Core/Buffer.h>
 #include <vkpp/Core/Device.h>
+#include <vkpp/Core/SparsePageTable.h>
 
 namespace vkpp
 {
@@ -13,16 +14,93 @@ Buffer::Buffer(
     VK_CHECK(vmaCreateBuffer(m_device->GetAllocator(), &createInfo, &allocInfo,
         &m_handle, &m_allocation, &m_allocationInfo));
 
+    m_createFlags = createInfo.flags;
     m_size = createInfo.size;
     m_usage = createInfo.usage;
     m_sharingMode = createInfo.sharingMode;
+    // Find the buffer of an allocation moved by defragmentation.
+    vmaSetAllocationUserData(m_device->GetAllocator(), m_allocation, this);
 
     vmaGetMemoryTypeProperties(
         m_device->GetAllocator(), m_allocationInfo.memoryType, &m_memoryFlags);
+
+    // Map once instead of on each access: vmaMapMemory/vmaUnmapMemory are not free,
+    // and reads and writes of small ranges are frequent.
+    if (m_allocationInfo.pMappedData)
+    {
+        m_mappedData = static_cast<uint8_t*>(m_allocationInfo.pMappedData);
+    }
+    else if (IsHostVisible())
+    {
+        void* pMappedAddr = nullptr;
+        VK_CHECK(vmaMapMemory(m_device->GetAllocator(), m_allocation, &pMappedAddr));
+        m_mappedData = static_cast<uint8_t*>(pMappedAddr);
+        m_isMappedOnCreate = true;
+    }
+
+    // The address is constant for the lifetime of the handle, query once.
+    if (rad::HasBits<uint32_t>(m_usage, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT))
+    {
+        VkBufferDeviceAddressInfo deviceAddressInfo = {};
+        deviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        deviceAddressInfo.pNext = nullptr;
+        deviceAddressInfo.buffer = m_handle;
+        m_deviceAddress = m_device->GetFunctionTable()->
+            vkGetBufferDeviceAddress(m_device->GetHandle(), &deviceAddressInfo);
+    }
+
+    if (IsMovable())
+    {
+        ++m_device->m_movableBufferCount;
+    }
+}
+
+Buffer::Buffer(
+    rad::Ref<Device> device,
+    const VkBufferCreateInfo& createInfo) :
+    m_device(std::move(device))
+{
+    assert(rad::HasBits<uint32_t>(createInfo.flags,
+        VK_BUFFER_CREATE_SPARSE_BINDING_BIT | VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT));
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkCreateBuffer(m_device->GetHandle(), &createInfo, nullptr, &m_handle));
+
+    m_createFlags = createInfo.flags;
+    m_size = createInfo.size;
+    m_usage = createInfo.usage;
+    m_sharingMode = createInfo.sharingMode;
+    // The memory of the pages is device local, but is not host visible.
+    m_memoryFlags = 0;
+    m_pageTable = RAD_NEW SparsePageTable(m_device, m_handle);
+
+    if (rad::HasBits<uint32_t>(m_usage, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT))
+    {
+        VkBufferDeviceAddressInfo deviceAddressInfo = {};
+        deviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        deviceAddressInfo.pNext = nullptr;
+        deviceAddressInfo.buffer = m_handle;
+        m_deviceAddress = m_device->GetFunctionTable()->
+            vkGetBufferDeviceAddress(m_device->GetHandle(), &deviceAddressInfo);
+    }
 }
 
 Buffer::~Buffer()
 {
+    if (m_pageTable)
+    {
+        // The memory of the pages is freed by the page table, after.
+        m_device->GetFunctionTable()->
+            vkDestroyBuffer(m_device->GetHandle(), m_handle, nullptr);
+        return;
+    }
+    if (IsMovable())
+    {
+        --m_device->m_movableBufferCount;
+    }
+    if (m_isMappedOnCreate)
+    {
+        vmaUnmapMemory(m_device->GetAllocator(), m_allocation);
+    }
     vmaDestroyBuffer(m_device->GetAllocator(), m_handle, m_allocation);
 }
 
@@ -36,27 +114,52 @@ bool Buffer::IsHostCoherent() const
     return rad::HasBits<uint32_t>(m_memoryFlags, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 }
 
-VkDeviceAddress Buffer::GetDeviceAddress() const
+bool Buffer::IsHostCached() const
+{
+    return rad::HasBits<uint32_t>(m_memoryFlags, VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+}
+
+bool Buffer::IsDeviceLocal() const
 {
-    VkBufferDeviceAddressInfo deviceAddressInfo = {};
-    deviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
-    deviceAddressInfo.pNext = nullptr;
-    deviceAddressInfo.buffer = m_handle;
-    return vkGetBufferDeviceAddress(m_device->GetHandle(), &deviceAddressInfo);
+    return rad::HasBits<uint32_t>(m_memoryFlags, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+bool Buffer::IsMovable() const
+{
+    const VkBufferUsageFlags transferUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    return (m_allocation != nullptr) && (m_mappedData == nullptr) && (m_createFlags == 0) &&
+        (m_sharingMode == VK_SHARING_MODE_EXCLUSIVE) && rad::HasBits<uint32_t>(m_usage, transferUsage);
+}
+
+void Buffer::ReplaceHandle(VkBuffer handle)
+{
+    assert(IsMovable());
+    m_device->GetFunctionTable()->
+        vkDestroyBuffer(m_device->GetHandle(), m_handle, nullptr);
+    m_handle = handle;
+    vmaGetAllocationInfo(m_device->GetAllocator(), m_allocation, &m_allocationInfo);
+    if (m_deviceAddress != 0)
+    {
+        VkBufferDeviceAddressInfo deviceAddressInfo = {};
+        deviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        deviceAddressInfo.pNext = nullptr;
+        deviceAddressInfo.buffer = m_handle;
+        m_deviceAddress = m_device->GetFunctionTable()->
+            vkGetBufferDeviceAddress(m_device->GetHandle(), &deviceAddressInfo);
+    }
 }
 
 void* Buffer::GetMappedAddr()
 {
-    return m_allocationInfo.pMappedData;
+    return m_mappedData;
 }
 
 void* Buffer::MapMemory(VkDeviceSize offset, VkDeviceSize size)
 {
-    if (IsHostVisible())
+    assert(offset + size <= m_size);
+    if (m_mappedData)
     {
-        void* pMappedAddr = nullptr;
-        VK_CHECK(vmaMapMemory(m_device->GetAllocator(), m_allocation, &pMappedAddr));
-        return pMappedAddr;
+        return m_mappedData + offset;
     }
     else
     {
@@ -71,7 +174,6 @@ void* Buffer::MapMemory()
 
 void Buffer::UnmapMemory()
 {
-    vmaUnmapMemory(m_device->GetAllocator(), m_allocation);
 }
 
 void Buffer::FlushAllocation(VkDeviceSize offset, VkDeviceSize size)
@@ -133,7 +235,6 @@ void Buffer::Read(void* dest, VkDeviceSize offset, VkDeviceSize size)
             InvalidateAllocation(offset, size);
         }
         memcpy(dest, pMappedAddr, size);
-        UnmapMemory();
     }
 }
 
@@ -153,7 +254,6 @@ void Buffer::Write(const void* data, VkDeviceSize offset, VkDeviceSize size)
         {
             FlushAllocation(offset, size);
         }
-        UnmapMemory();
     }
 }
 
@@ -12,6 +12,11 @@ public:
         rad::Ref<Device> device,
         const VkBufferCreateInfo& createInfo,
         const VmaAllocationCreateInfo& allocInfo);
+    // Sparse buffer (VK_BUFFER_CREATE_SPARSE_BINDING_BIT and VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT):
+    // no memory is bound on creation, pages are committed by the page table.
+    Buffer(
+        rad::Ref<Device> device,
+        const VkBufferCreateInfo& createInfo);
     ~Buffer();
     VKPP_DISABLE_COPY_AND_MOVE(Buffer);
 
@@ -22,14 +27,32 @@ public:
     VkMemoryPropertyFlags GetMemoryFlags() const { return m_memoryFlags; }
     bool IsHostVisible() const;
     bool IsHostCoherent() const;
+    bool IsHostCached() const;
+    bool IsDeviceLocal() const;
     VmaAllocation GetAllocation() { return m_allocation; }
     const VmaAllocationInfo& GetAllocationInfo() const { return m_allocationInfo; }
-    VkDeviceAddress GetDeviceAddress() const;
-
+    // 0 if the buffer is not created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT.
+    VkDeviceAddress GetDeviceAddress() const { return m_deviceAddress; }
+    bool IsSparse() const { return m_pageTable != nullptr; }
+    // nullptr if the buffer is not sparse.
+    SparsePageTable* GetPageTable() const { return m_pageTable.get(); }
+
+    // Can be moved by Device::Defragment: allocated by VMA, not mapped by the host (pointers to the memory
+    // may be kept), created without flags, exclusive, and usable as transfer source and destination.
+    bool IsMovable() const;
+    // Used by Device::Defragment, once the content is copied and the allocation moved:
+    // replace the handle with one bound to the new memory, and destroy the old one.
+    void ReplaceHandle(VkBuffer handle);
+
+    // Host visible buffers are mapped for their whole lifetime (persistent mapping):
+    // nullptr if the memory is not host visible.
     void* GetMappedAddr();
+    // Return the address of the range (offset from the start of the buffer), nullptr if not host visible;
+    // no map call is made, the memory stays mapped.
     void* MapMemory(VkDeviceSize offset, VkDeviceSize size);
     // Map whole range.
     void* MapMemory();
+    // Balance MapMemory, the memory stays mapped until the buffer is destroyed.
     void UnmapMemory();
     void FlushAllocation(VkDeviceSize offset, VkDeviceSize size);
     void FlushAllocation();
@@ -51,12 +74,18 @@ public:
 private:
     rad::Ref<Device>        m_device;
     VkBuffer                m_handle = VK_NULL_HANDLE;
+    VkBufferCreateFlags     m_createFlags = 0;
     VkDeviceSize            m_size = 0;
     VkBufferUsageFlags      m_usage;
     VkSharingMode           m_sharingMode;
-    VmaAllocation           m_allocation;
-    VmaAllocationInfo       m_allocationInfo;
+    VmaAllocation           m_allocation = nullptr;
+    VmaAllocationInfo       m_allocationInfo = {};
     VkMemoryPropertyFlags   m_memoryFlags;
+    VkDeviceAddress         m_deviceAddress = 0;
+    uint8_t*                m_mappedData = nullptr;
+    // Mapped by the constructor (not created with VMA_ALLOCATION_CREATE_MAPPED_BIT), unmapped on destruction.
+    bool                    m_isMappedOnCreate = false;
+    rad::Ref<SparsePageTable> m_pageTable;
 
 }; // class Buffer
 
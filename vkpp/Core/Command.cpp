@@ -3,6 +3,7 @@
 #include <vkpp/Core/Fence.h>
 #include <vkpp/Core/Semaphore.h>
 #include <vkpp/Core/Event.h>
+#include <vkpp/Core/QueryPool.h>
 #include <vkpp/Core/RenderPass.h>
 #include <vkpp/Core/Framebuffer.h>
 #include <vkpp/Core/Pipeline.h>
@@ -10,6 +11,7 @@
 #include <vkpp/Core/Image.h>
 #include <vkpp/Core/Sampler.h>
 #include <vkpp/Core/Descriptor.h>
+#include <vkpp/Core/DescriptorBuffer.h>
 #include <vkpp/Core/Swapchain.h>
 
 #include <rad/Container/SmallVector.h>
@@ -264,6 +266,53 @@ void CommandBuffer::BindDescriptorSets(
             static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
 
+void CommandBuffer::PushDescriptorSet(
+    Pipeline* pipeline,
+    PipelineLayout* layout,
+    uint32_t set,
+    rad::Span<VkWriteDescriptorSet> writes)
+{
+    m_device->GetFunctionTable()->
+        vkCmdPushDescriptorSetKHR(m_handle, pipeline->GetBindPoint(), layout->GetHandle(),
+            set, static_cast<uint32_t>(writes.size()), writes.data());
+}
+
+void CommandBuffer::BindDescriptorBuffers(rad::Span<DescriptorBuffer*> descBuffers)
+{
+    rad::SmallVector<VkDescriptorBufferBindingInfoEXT, 4> bindingInfos(descBuffers.size());
+    for (size_t i = 0; i < descBuffers.size(); i++)
+    {
+        bindingInfos[i] = descBuffers[i]->GetBindingInfo();
+    }
+    m_device->GetFunctionTable()->
+        vkCmdBindDescriptorBuffersEXT(m_handle,
+            static_cast<uint32_t>(bindingInfos.size()), bindingInfos.data());
+}
+
+void CommandBuffer::SetDescriptorBufferOffsets(
+    Pipeline* pipeline,
+    PipelineLayout* layout,
+    uint32_t firstSet,
+    rad::Span<uint32_t> bufferIndices,
+    rad::Span<VkDeviceSize> offsets)
+{
+    assert(bufferIndices.size() == offsets.size());
+    m_device->GetFunctionTable()->
+        vkCmdSetDescriptorBufferOffsetsEXT(m_handle, pipeline->GetBindPoint(), layout->GetHandle(),
+            firstSet, static_cast<uint32_t>(offsets.size()), bufferIndices.data(), offsets.data());
+}
+
+void CommandBuffer::PushDescriptorSetWithTemplate(
+    DescriptorUpdateTemplate* updateTemplate,
+    PipelineLayout* layout,
+    uint32_t set,
+    const void* data)
+{
+    m_device->GetFunctionTable()->
+        vkCmdPushDescriptorSetWithTemplateKHR(m_handle, updateTemplate->GetHandle(),
+            layout->GetHandle(), set, data);
+}
+
 void CommandBuffer::SetScissors(rad::Span<VkRect2D> scissors, uint32_t first)
 {
     m_device->GetFunctionTable()->
@@ -401,6 +450,18 @@ void CommandBuffer::DispatchBase(
         groupCountX, groupCountY, groupCountZ);
 }
 
+void CommandBuffer::ResetQueryPool(QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+    m_device->GetFunctionTable()->
+        vkCmdResetQueryPool(m_handle, queryPool->GetHandle(), firstQuery, queryCount);
+}
+
+void CommandBuffer::WriteTimestamp(VkPipelineStageFlagBits stage, QueryPool* queryPool, uint32_t query)
+{
+    m_device->GetFunctionTable()->
+        vkCmdWriteTimestamp(m_handle, stage, queryPool->GetHandle(), query);
+}
+
 void CommandBuffer::ClearColorImage(
     Image* image,
     VkImageLayout layout,
@@ -78,6 +78,28 @@ public:
         uint32_t firstSet,
         rad::Span<DescriptorSet*> descSets,
         rad::Span<uint32_t> dynamicOffsets = {});
+    // VK_KHR_push_descriptor: record the descriptors in the command buffer, without a descriptor set;
+    // the layout of the set must be created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR.
+    // dstSet of the writes is ignored.
+    void PushDescriptorSet(
+        Pipeline* pipeline,
+        PipelineLayout* layout,
+        uint32_t set,
+        rad::Span<VkWriteDescriptorSet> writes);
+    // VK_EXT_descriptor_buffer: bind the buffers, then select the set ranges by (buffer index, offset).
+    void BindDescriptorBuffers(rad::Span<DescriptorBuffer*> descBuffers);
+    void SetDescriptorBufferOffsets(
+        Pipeline* pipeline,
+        PipelineLayout* layout,
+        uint32_t firstSet,
+        rad::Span<uint32_t> bufferIndices,
+        rad::Span<VkDeviceSize> offsets);
+    // @param updateTemplate: of VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR for the layout and set.
+    void PushDescriptorSetWithTemplate(
+        DescriptorUpdateTemplate* updateTemplate,
+        PipelineLayout* layout,
+        uint32_t set,
+        const void* data);
 
     void SetScissors(rad::Span<VkRect2D> scissors, uint32_t first = 0);
     void SetViewports(rad::Span<VkViewport> viewports, uint32_t first = 0);
@@ -122,6 +144,11 @@ public:
         uint32_t baseGroupX, uint32_t baseGroupY, uint32_t baseGroupZ,
         uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
 
+    // Query
+
+    void ResetQueryPool(QueryPool* queryPool, uint32_t firstQuery, uint32_t queryCount);
+    void WriteTimestamp(VkPipelineStageFlagBits stage, QueryPool* queryPool, uint32_t query);
+
     // Clear
 
     void ClearColorImage(
@@ -72,6 +72,7 @@ class CommandBuffer;
 class Fence;
 class Semaphore;
 class Event;
+class QueryPool;
 class RenderPass;
 class Framebuffer;
 class ShaderModule;
@@ -85,8 +86,15 @@ class Image;
 class ImageView;
 class Sampler;
 class DescriptorPool;
+class DescriptorAllocator;
 class DescriptorSetLayout;
 class DescriptorSet;
+class DescriptorUpdateTemplate;
+class DescriptorBuffer;
+class BindlessTextureTable;
+class ResidentResource;
+class ResidencyManager;
+class SparsePageTable;
 class Surface;
 class Swapchain;
 
@@ -87,7 +87,11 @@ bool Context::Init(rad::Ref<Instance> instance, rad::Ref<PhysicalDevice> gpuSele
         QueueFamily queueFamily = QueueFamily(i);
         if (m_device->IsQueueFamilySupported(queueFamily))
         {
-            m_queues[i] = m_device->CreateQueue(QueueFamily(queueFamily));
+            uint32_t queueCount = m_device->GetQueueCount(queueFamily);
+            for (uint32_t queueIndex = 0; queueIndex < queueCount; ++queueIndex)
+            {
+                m_queues[i].push_back(m_device->CreateQueue(queueFamily, queueIndex));
+            }
             m_cmdPools[i] = m_device->CreateCommandPool(
                 queueFamily, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
         }
@@ -108,15 +112,58 @@ void Context::WaitIdle()
     m_device->WaitIdle();
 }
 
+Queue* Context::GetSparseBindingQueue()
+{
+    for (uint32_t i = 0; i < QueueFamilyCount; ++i)
+    {
+        if (!m_queues[i].empty() && m_queues[i][0]->SupportSparseBinding())
+        {
+            return m_queues[i][0].get();
+        }
+    }
+    return nullptr;
+}
+
+bool Context::CommitSparseBuffer(Buffer* buffer, VkDeviceSize offset, VkDeviceSize size)
+{
+    SparsePageTable* pageTable = buffer->GetPageTable();
+    if (!pageTable)
+    {
+        return true;
+    }
+    Queue* queue = GetSparseBindingQueue();
+    if (!queue)
+    {
+        VKPP_LOG(err, "Context::CommitSparseBuffer: no queue supports sparse binding!");
+        return false;
+    }
+    return pageTable->Commit(queue, offset, size);
+}
+
+// Uncached device local memory (resizable BAR) is slow to read by the host:
+// copy it to a readback buffer if the buffer can be a transfer source.
+static bool CanReadDirectly(Buffer* buffer)
+{
+    if (!buffer->IsHostVisible())
+    {
+        return false;
+    }
+    if (buffer->IsHostCached() || !buffer->IsDeviceLocal())
+    {
+        return true;
+    }
+    return !rad::HasBits<uint32_t>(buffer->GetUsage(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+}
+
 void Context::ReadBuffer(Buffer* buffer, void* dest, VkDeviceSize offset, VkDeviceSize size)
 {
-    if (buffer->IsHostVisible())
+    if (CanReadDirectly(buffer))
     {
         buffer->Read(dest, offset, size);
     }
     else
     {
-        rad::Ref<Buffer> stagingBuffer = m_device->CreateStagingBuffer(size);
+        rad::Ref<Buffer> stagingBuffer = m_device->CreateReadbackBuffer(size);
 
         QueueFamily queueFamily = QueueFamilyUniversal;
         rad::Ref<CommandBuffer> cmdBuffer = AllocateTransientCommandBuffer(queueFamily);
@@ -182,6 +229,10 @@ void Context::WriteBuffer(
     }
     else
     {
+        if (!CommitSparseBuffer(buffer, offset, size))
+        {
+            return;
+        }
         QueueFamily queueFamily = QueueFamilyUniversal;
         rad::Ref<Buffer> stagingBuffer = m_device->CreateStagingBuffer(size);
         stagingBuffer->Write(data);
@@ -203,6 +254,289 @@ void Context::WriteBuffer(Buffer* buffer, const void* data)
     WriteBuffer(buffer, data, 0, buffer->GetSize());
 }
 
+void Context::WriteBufferStreamed(Buffer* buffer, VkDeviceSize offset, VkDeviceSize size,
+    const BufferWriteCallback& fill, VkDeviceSize chunkSize)
+{
+    if (chunkSize == 0)
+    {
+        VKPP_LOG(err, "Context: the chunk size of a streamed transfer must not be zero!");
+        return;
+    }
+    if (size == 0)
+    {
+        return;
+    }
+
+    if (buffer->IsHostVisible())
+    {
+        uint8_t* pMappedAddr = static_cast<uint8_t*>(buffer->MapMemory());
+        for (VkDeviceSize chunkOffset = 0; chunkOffset < size; chunkOffset += chunkSize)
+        {
+            VkDeviceSize copySize = std::min(chunkSize, size - chunkOffset);
+            fill(pMappedAddr + offset + chunkOffset, chunkOffset, copySize);
+        }
+        if (!buffer->IsHostCoherent())
+        {
+            buffer->FlushAllocation(offset, size);
+        }
+        buffer->UnmapMemory();
+        return;
+    }
+
+    if (!CommitSparseBuffer(buffer, offset, size))
+    {
+        return;
+    }
+
+    chunkSize = std::min(chunkSize, size);
+    QueueFamily queueFamily = QueueFamilyUniversal;
+    Queue* queue = GetQueue(queueFamily);
+
+    rad::Ref<Buffer> stagingBuffers[2];
+    rad::Ref<Fence> fences[2];
+    // Keep the command buffers alive until the fences are signaled.
+    rad::Ref<CommandBuffer> cmdBuffers[2];
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        stagingBuffers[i] = m_device->CreateStagingBuffer(chunkSize, true);
+        fences[i] = m_device->CreateFence();
+    }
+
+    uint32_t chunkIndex = 0;
+    for (VkDeviceSize chunkOffset = 0; chunkOffset < size; chunkOffset += chunkSize, ++chunkIndex)
+    {
+        uint32_t slot = chunkIndex % 2;
+        if (cmdBuffers[slot])
+        {
+            // Wait until the previous copy from this staging buffer completes.
+            fences[slot]->Wait();
+            fences[slot]->Reset();
+            cmdBuffers[slot].reset();
+        }
+
+        Buffer* stagingBuffer = stagingBuffers[slot].get();
+        VkDeviceSize copySize = std::min(chunkSize, size - chunkOffset);
+        fill(stagingBuffer->GetMappedAddr(), chunkOffset, copySize);
+        if (!stagingBuffer->IsHostCoherent())
+        {
+            stagingBuffer->FlushAllocation(0, copySize);
+        }
+
+        // The transient command pool cannot reset individual command buffers,
+        // allocate a new one for each chunk.
+        cmdBuffers[slot] = AllocateTransientCommandBuffer(queueFamily);
+        CommandBuffer* cmdBuffer = cmdBuffers[slot].get();
+        cmdBuffer->Begin();
+        if (chunkIndex == 0)
+        {
+            // Commands submitted before may still access the range; the barrier also covers later chunks.
+            VkBufferMemoryBarrier dstBarrier = {};
+            dstBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            dstBarrier.pNext = nullptr;
+            dstBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            dstBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            dstBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            dstBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            dstBarrier.buffer = buffer->GetHandle();
+            dstBarrier.offset = offset;
+            dstBarrier.size = size;
+            cmdBuffer->SetPipelineBarrier(
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                {}, dstBarrier, {});
+        }
+        VkBufferCopy copyRegion = {};
+        copyRegion.srcOffset = 0;
+        copyRegion.dstOffset = offset + chunkOffset;
+        copyRegion.size = copySize;
+        cmdBuffer->CopyBuffer(stagingBuffer, buffer, copyRegion);
+        cmdBuffer->End();
+        queue->Submit(cmdBuffer, {}, {}, fences[slot].get());
+    }
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        if (cmdBuffers[i])
+        {
+            fences[i]->Wait();
+        }
+    }
+}
+
+void Context::ReadBufferStreamed(Buffer* buffer, VkDeviceSize offset, VkDeviceSize size,
+    const BufferReadCallback& consume, VkDeviceSize chunkSize)
+{
+    if (chunkSize == 0)
+    {
+        VKPP_LOG(err, "Context: the chunk size of a streamed transfer must not be zero!");
+        return;
+    }
+    if (size == 0)
+    {
+        return;
+    }
+
+    if (CanReadDirectly(buffer))
+    {
+        const uint8_t* pMappedAddr = static_cast<const uint8_t*>(buffer->MapMemory());
+        if (!buffer->IsHostCoherent())
+        {
+            buffer->InvalidateAllocation(offset, size);
+        }
+        for (VkDeviceSize chunkOffset = 0; chunkOffset < size; chunkOffset += chunkSize)
+        {
+            VkDeviceSize copySize = std::min(chunkSize, size - chunkOffset);
+            consume(pMappedAddr + offset + chunkOffset, chunkOffset, copySize);
+        }
+        buffer->UnmapMemory();
+        return;
+    }
+
+    chunkSize = std::min(chunkSize, size);
+    QueueFamily queueFamily = QueueFamilyUniversal;
+    Queue* queue = GetQueue(queueFamily);
+
+    rad::Ref<Buffer> stagingBuffers[2];
+    rad::Ref<Fence> fences[2];
+    rad::Ref<CommandBuffer> cmdBuffers[2];
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        stagingBuffers[i] = m_device->CreateReadbackBuffer(chunkSize);
+        fences[i] = m_device->CreateFence();
+    }
+
+    // Record and submit the copy of a chunk into the staging buffer of the slot.
+    auto submitChunk = [&](uint32_t slot, VkDeviceSize chunkOffset, bool isFirstChunk)
+    {
+        VkDeviceSize copySize = std::min(chunkSize, size - chunkOffset);
+        cmdBuffers[slot] = AllocateTransientCommandBuffer(queueFamily);
+        CommandBuffer* cmdBuffer = cmdBuffers[slot].get();
+        Buffer* stagingBuffer = stagingBuffers[slot].get();
+        cmdBuffer->Begin();
+
+        if (isFirstChunk)
+        {
+            VkBufferMemoryBarrier srcBarrier = {};
+            srcBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            srcBarrier.pNext = nullptr;
+            srcBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            srcBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            srcBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            srcBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            srcBarrier.buffer = buffer->GetHandle();
+            srcBarrier.offset = offset;
+            srcBarrier.size = size;
+            cmdBuffer->SetPipelineBarrier(
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                {}, srcBarrier, {});
+        }
+
+        VkBufferCopy copyRegion = {};
+        copyRegion.srcOffset = offset + chunkOffset;
+        copyRegion.dstOffset = 0;
+        copyRegion.size = copySize;
+        cmdBuffer->CopyBuffer(buffer, stagingBuffer, copyRegion);
+
+        VkBufferMemoryBarrier hostReadBarrier = {};
+        hostReadBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        hostReadBarrier.pNext = nullptr;
+        hostReadBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostReadBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        hostReadBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        hostReadBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        hostReadBarrier.buffer = stagingBuffer->GetHandle();
+        hostReadBarrier.offset = 0;
+        hostReadBarrier.size = copySize;
+        cmdBuffer->SetPipelineBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT,
+            0,
+            {}, hostReadBarrier, {});
+
+        cmdBuffer->End();
+        queue->Submit(cmdBuffer, {}, {}, fences[slot].get());
+    };
+
+    submitChunk(0, 0, true);
+    uint32_t chunkIndex = 0;
+    for (VkDeviceSize chunkOffset = 0; chunkOffset < size; chunkOffset += chunkSize, ++chunkIndex)
+    {
+        uint32_t slot = chunkIndex % 2;
+        // Keep the GPU busy with the next chunk while the host consumes this one.
+        VkDeviceSize nextChunkOffset = chunkOffset + chunkSize;
+        if (nextChunkOffset < size)
+        {
+            submitChunk(1 - slot, nextChunkOffset, false);
+        }
+
+        fences[slot]->Wait();
+        fences[slot]->Reset();
+        cmdBuffers[slot].reset();
+
+        Buffer* stagingBuffer = stagingBuffers[slot].get();
+        VkDeviceSize copySize = std::min(chunkSize, size - chunkOffset);
+        if (!stagingBuffer->IsHostCoherent())
+        {
+            stagingBuffer->InvalidateAllocation(0, copySize);
+        }
+        consume(stagingBuffer->GetMappedAddr(), chunkOffset, copySize);
+    }
+}
+
+std::vector<rad::Ref<Buffer>> Context::DefragmentMemory(float fragmentationThreshold)
+{
+    if (m_device->GetMovableBufferCount() == 0)
+    {
+        return {};
+    }
+    const float fragmentation = m_device->GetFragmentation();
+    if ((fragmentation <= fragmentationThreshold) || (fragmentation == m_defragmentedFragmentation))
+    {
+        return {};
+    }
+    VKPP_LOG(info, "Context: defragment the device memory (fragmentation={:.2f}).", fragmentation);
+    WaitIdle();
+    std::vector<rad::Ref<Buffer>> movedBuffers = m_device->Defragment(GetQueue());
+    m_defragmentedFragmentation = m_device->GetFragmentation();
+    return movedBuffers;
+}
+
+void Context::CopyBuffer(Buffer* srcBuffer, Buffer* dstBuffer, rad::Span<VkBufferCopy> regions)
+{
+    for (const VkBufferCopy& region : regions)
+    {
+        if (!CommitSparseBuffer(dstBuffer, region.dstOffset, region.size))
+        {
+            return;
+        }
+    }
+    rad::Ref<CommandBuffer> commandBuffer = AllocateTransientCommandBuffer();
+    commandBuffer->Begin();
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    commandBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        barrier, {}, {});
+    commandBuffer->CopyBuffer(srcBuffer, dstBuffer, regions);
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_HOST_READ_BIT;
+    commandBuffer->SetPipelineBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        barrier, {}, {});
+    commandBuffer->End();
+    GetQueue()->SubmitAndWait(commandBuffer.get());
+}
+
 void Context::CopyBufferToImage(Buffer* buffer, Image* image, rad::Span<VkBufferImageCopy> copyInfos)
 {
     rad::Ref<CommandBuffer> commandBuffer = AllocateTransientCommandBuffer();
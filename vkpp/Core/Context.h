@@ -8,6 +8,7 @@
 #include <vkpp/Core/Fence.h>
 #include <vkpp/Core/Semaphore.h>
 #include <vkpp/Core/Event.h>
+#include <vkpp/Core/QueryPool.h>
 #include <vkpp/Core/RenderPass.h>
 #include <vkpp/Core/Framebuffer.h>
 #include <vkpp/Core/Pipeline.h>
@@ -15,9 +16,14 @@
 #include <vkpp/Core/Image.h>
 #include <vkpp/Core/Sampler.h>
 #include <vkpp/Core/Descriptor.h>
+#include <vkpp/Core/DescriptorBuffer.h>
+#include <vkpp/Core/BindlessTextureTable.h>
+#include <vkpp/Core/ResidencyManager.h>
+#include <vkpp/Core/SparsePageTable.h>
 #include <vkpp/Core/Surface.h>
 #include <vkpp/Core/Swapchain.h>
 
+#include <functional>
 #include <mutex>
 
 namespace vkpp
@@ -33,9 +39,14 @@ public:
     bool Init(rad::Ref<Instance> instance, rad::Ref<PhysicalDevice> gpu);
     Instance* GetInstance() { return m_instance.get(); }
     Device* GetDevice() { return m_device.get(); }
-    Queue* GetQueue(QueueFamily family = QueueFamilyUniversal)
+    // The device creates all queues of the families that support compute (async compute queues).
+    Queue* GetQueue(QueueFamily family = QueueFamilyUniversal, uint32_t queueIndex = 0)
     {
-        return m_queues[family].get();
+        return (queueIndex < m_queues[family].size()) ? m_queues[family][queueIndex].get() : nullptr;
+    }
+    uint32_t GetQueueCount(QueueFamily family) const
+    {
+        return static_cast<uint32_t>(m_queues[family].size());
     }
     rad::Ref<CommandBuffer> AllocateTransientCommandBuffer(
         QueueFamily queueFamily = QueueFamilyUniversal,
@@ -43,11 +54,39 @@ public:
 
     void WaitIdle();
 
+    // The first queue that supports sparse binding (preferred in the universal family), nullptr if none.
+    Queue* GetSparseBindingQueue();
+    // Commit the pages of the range of a sparse buffer (Buffer::GetPageTable), nothing for other buffers;
+    // called by the writes below (commit on first write). Return false if the memory cannot be committed.
+    bool CommitSparseBuffer(Buffer* buffer, VkDeviceSize offset, VkDeviceSize size);
+
+    // Host visible buffers are written directly (see Device::SetDirectUploadEnabled), and read directly
+    // unless the memory is uncached device memory (slow to read by the host), which is copied to a readback buffer.
     void ReadBuffer(Buffer* buffer, void* dest, VkDeviceSize offset, VkDeviceSize size);
     void ReadBuffer(Buffer* buffer, void* dest);
     void WriteBuffer(Buffer* buffer, const void* data, VkDeviceSize offset, VkDeviceSize size);
     void WriteBuffer(Buffer* buffer, const void* data);
 
+    // Chunked transfers for ranges too large to stage at once: two persistent mapped
+    // staging buffers are used in turn, so the host can produce/consume one chunk
+    // while the GPU copies the other. Callbacks receive the chunk offset relative to
+    // the beginning of the range. chunkSize must not be zero.
+    using BufferWriteCallback = std::function<void(void* dest, VkDeviceSize offset, VkDeviceSize size)>;
+    using BufferReadCallback = std::function<void(const void* src, VkDeviceSize offset, VkDeviceSize size)>;
+    static constexpr VkDeviceSize DefaultStreamChunkSize = 64ull * 1024 * 1024;
+    void WriteBufferStreamed(Buffer* buffer, VkDeviceSize offset, VkDeviceSize size,
+        const BufferWriteCallback& fill, VkDeviceSize chunkSize = DefaultStreamChunkSize);
+    void ReadBufferStreamed(Buffer* buffer, VkDeviceSize offset, VkDeviceSize size,
+        const BufferReadCallback& consume, VkDeviceSize chunkSize = DefaultStreamChunkSize);
+
+    // Defragment the device memory (Device::Defragment) if the fragmentation exceeds the threshold,
+    // after waiting for the device to be idle; return the buffers moved, whose descriptors must be rewritten.
+    // Nothing is done (no wait) if no buffer is movable, or if the fragmentation is unchanged since
+    // the last defragmentation (the rest is not movable).
+    std::vector<rad::Ref<Buffer>> DefragmentMemory(float fragmentationThreshold = 0.25f);
+
+    // Copy and wait, after all commands submitted before; the buffers can be used by any command after.
+    void CopyBuffer(Buffer* srcBuffer, Buffer* dstBuffer, rad::Span<VkBufferCopy> regions);
     void CopyBufferToImage(Buffer* buffer, Image* image, rad::Span<VkBufferImageCopy> copyInfos);
     void CopyBufferToImage2D(Buffer* buffer, VkDeviceSize bufferOffset,
         Image* image, uint32_t baseMipLevel = 0, uint32_t levelCount = 1,
@@ -55,7 +94,7 @@ public:
 
     rad::Ref<Instance> m_instance;
     rad::Ref<Device> m_device;
-    rad::Ref<Queue> m_queues[QueueFamilyCount];
+    std::vector<rad::Ref<Queue>> m_queues[QueueFamilyCount];
     // Host access to command pools must be externally synchronized.
     std::mutex m_cmdPoolMutex;
     rad::Ref<CommandPool> m_cmdPools[QueueFamilyCount];
@@ -65,6 +104,10 @@ public:
     VkFormat m_colorFormat = VK_FORMAT_R8G8B8A8_UNORM;
     VkFormat m_depthStencilFormat = VK_FORMAT_D32_SFLOAT_S8_UINT;
 
+private:
+    // The fragmentation left by the last DefragmentMemory, negative if none.
+    float m_defragmentedFragmentation = -1.0f;
+
 }; // class Context
 
 } // namespace vkpp
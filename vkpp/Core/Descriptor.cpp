@@ -4,13 +4,16 @@
 #include <vkpp/Core/Image.h>
 #include <vkpp/Core/Sampler.h>
 
+#include <algorithm>
+
 namespace vkpp
 {
 
 DescriptorPool::DescriptorPool(
     rad::Ref<Device> device,
     const VkDescriptorPoolCreateInfo& createInfo) :
-    m_device(std::move(device))
+    m_device(std::move(device)),
+    m_flags(createInfo.flags)
 {
     VK_CHECK(m_device->GetFunctionTable()->
         vkCreateDescriptorPool(m_device->GetHandle(), &createInfo, nullptr, &m_handle));
@@ -25,13 +28,142 @@ DescriptorPool::~DescriptorPool()
 
 rad::Ref<DescriptorSet> DescriptorPool::Allocate(DescriptorSetLayout* layout)
 {
-    return RAD_NEW DescriptorSet(m_device, this, layout);
+    VkDescriptorSetLayout layoutHandle = layout->GetHandle();
+
+    VkDescriptorSetAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.pNext = nullptr;
+    allocateInfo.descriptorPool = m_handle;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &layoutHandle;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    VkDescriptorSet handle = VK_NULL_HANDLE;
+    VkResult allocResult = m_device->GetFunctionTable()->
+        vkAllocateDescriptorSets(m_device->GetHandle(), &allocateInfo, &handle);
+    if ((allocResult == VK_ERROR_OUT_OF_POOL_MEMORY) || (allocResult == VK_ERROR_FRAGMENTED_POOL))
+    {
+        return nullptr;
+    }
+    VK_CHECK(allocResult);
+    return RAD_NEW DescriptorSet(m_device, this, layout, handle);
 }
 
 void DescriptorPool::Reset()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     VK_CHECK(m_device->GetFunctionTable()->
         vkResetDescriptorPool(m_device->GetHandle(), m_handle, 0));
+    ++m_resetGeneration;
+}
+
+void DescriptorPool::Free(VkDescriptorSet handle, uint64_t resetGeneration)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // The set is already freed if the pool is reset after the allocation.
+    if (resetGeneration == m_resetGeneration)
+    {
+        VK_CHECK(m_device->GetFunctionTable()->
+            vkFreeDescriptorSets(m_device->GetHandle(), m_handle, 1, &handle));
+    }
+}
+
+DescriptorAllocator::DescriptorAllocator(
+    rad::Ref<Device> device,
+    rad::Span<VkDescriptorPoolSize> poolSizes,
+    uint32_t frameCount,
+    uint32_t initialSetCount,
+    VkDescriptorPoolCreateFlags poolFlags) :
+    m_device(std::move(device)),
+    m_poolSizes(poolSizes.begin(), poolSizes.end()),
+    m_poolFlags(poolFlags),
+    m_setCountPerPool(std::clamp<uint32_t>(initialSetCount, 1, MaxSetCountPerPool))
+{
+    m_frames.resize(std::max(frameCount, 1u));
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+}
+
+void DescriptorAllocator::SetFrameIndex(uint32_t frameIndex)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(frameIndex < m_frames.size());
+    m_frameIndex = frameIndex;
+}
+
+void DescriptorAllocator::ResetFrame(uint32_t frameIndex)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(frameIndex < m_frames.size());
+    m_frameIndex = frameIndex;
+    Frame& frame = m_frames[frameIndex];
+    for (rad::Ref<DescriptorPool>& pool : frame.fullPools)
+    {
+        frame.pools.push_back(std::move(pool));
+    }
+    frame.fullPools.clear();
+    for (rad::Ref<DescriptorPool>& pool : frame.pools)
+    {
+        pool->Reset();
+    }
+}
+
+rad::Ref<DescriptorSet> DescriptorAllocator::Allocate(DescriptorSetLayout* layout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Frame& frame = m_frames[m_frameIndex];
+    while (!frame.pools.empty())
+    {
+        if (rad::Ref<DescriptorSet> descSet = frame.pools.back()->Allocate(layout))
+        {
+            return descSet;
+        }
+        frame.fullPools.push_back(std::move(frame.pools.back()));
+        frame.pools.pop_back();
+    }
+
+    // Sets released may have made room in the pools exhausted.
+    if (rad::HasBits<uint32_t>(m_poolFlags, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT))
+    {
+        for (auto iter = frame.fullPools.rbegin(); iter != frame.fullPools.rend(); ++iter)
+        {
+            if (rad::Ref<DescriptorSet> descSet = (*iter)->Allocate(layout))
+            {
+                return descSet;
+            }
+        }
+    }
+
+    frame.pools.push_back(CreatePool());
+    rad::Ref<DescriptorSet> descSet = frame.pools.back()->Allocate(layout);
+    if (!descSet)
+    {
+        VKPP_LOG(err, "DescriptorAllocator: the layout exceeds the pool sizes!");
+    }
+    return descSet;
+}
+
+rad::Ref<DescriptorPool> DescriptorAllocator::CreatePool()
+{
+    std::vector<VkDescriptorPoolSize> poolSizes(m_poolSizes);
+    for (VkDescriptorPoolSize& poolSize : poolSizes)
+    {
+        poolSize.descriptorCount *= m_setCountPerPool;
+    }
+
+    VkDescriptorPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = m_poolFlags;
+    createInfo.maxSets = m_setCountPerPool;
+    createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    createInfo.pPoolSizes = poolSizes.data();
+    rad::Ref<DescriptorPool> pool = m_device->CreateDescriptorPool(createInfo);
+
+    m_setCountPerPool = std::min(m_setCountPerPool * 2, MaxSetCountPerPool);
+    return pool;
 }
 
 DescriptorSetLayout::DescriptorSetLayout(
@@ -49,31 +181,59 @@ DescriptorSetLayout::~DescriptorSetLayout()
         vkDestroyDescriptorSetLayout(m_device->GetHandle(), m_handle, nullptr);
 }
 
+VkDeviceSize DescriptorSetLayout::GetDescriptorBufferSize() const
+{
+    VkDeviceSize size = 0;
+    m_device->GetFunctionTable()->
+        vkGetDescriptorSetLayoutSizeEXT(m_device->GetHandle(), m_handle, &size);
+    return size;
+}
+
+VkDeviceSize DescriptorSetLayout::GetDescriptorBufferBindingOffset(uint32_t binding) const
+{
+    VkDeviceSize offset = 0;
+    m_device->GetFunctionTable()->
+        vkGetDescriptorSetLayoutBindingOffsetEXT(m_device->GetHandle(), m_handle, binding, &offset);
+    return offset;
+}
+
+DescriptorUpdateTemplate::DescriptorUpdateTemplate(
+    rad::Ref<Device> device,
+    const VkDescriptorUpdateTemplateCreateInfo& createInfo) :
+    m_device(std::move(device))
+{
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkCreateDescriptorUpdateTemplate(m_device->GetHandle(), &createInfo, nullptr, &m_handle));
+}
+
+DescriptorUpdateTemplate::~DescriptorUpdateTemplate()
+{
+    m_device->GetFunctionTable()->
+        vkDestroyDescriptorUpdateTemplate(m_device->GetHandle(), m_handle, nullptr);
+    m_handle = VK_NULL_HANDLE;
+}
+
 DescriptorSet::DescriptorSet(
     rad::Ref<Device> device,
     rad::Ref<DescriptorPool> descriptorPool,
-    rad::Ref<DescriptorSetLayout> layout) :
+    rad::Ref<DescriptorSetLayout> layout,
+    VkDescriptorSet handle) :
     m_device(std::move(device)),
     m_descriptorPool(std::move(descriptorPool)),
-    m_layout(std::move(layout))
+    m_layout(std::move(layout)),
+    m_handle(handle),
+    // Constructed by DescriptorPool::Allocate, with the lock of the pool held.
+    m_poolResetGeneration(m_descriptorPool->m_resetGeneration)
 {
-    VkDescriptorSetLayout layoutHandle = m_layout->GetHandle();
-
-    VkDescriptorSetAllocateInfo allocateInfo = {};
-    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocateInfo.pNext = nullptr;
-    allocateInfo.descriptorPool = m_descriptorPool->GetHandle();
-    allocateInfo.descriptorSetCount = 1;
-    allocateInfo.pSetLayouts = &layoutHandle;
-
-    VK_CHECK(m_device->GetFunctionTable()->
-        vkAllocateDescriptorSets(m_device->GetHandle(), &allocateInfo, &m_handle));
 }
 
 DescriptorSet::~DescriptorSet()
 {
-    m_device->GetFunctionTable()->
-        vkFreeDescriptorSets(m_device->GetHandle(), m_descriptorPool->GetHandle(), 1, &m_handle);
+    // Sets of the other pools are freed when the pool is reset or destroyed.
+    if (rad::HasBits<uint32_t>(m_descriptorPool->GetFlags(), VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT))
+    {
+        m_descriptorPool->Free(m_handle, m_poolResetGeneration);
+    }
 }
 
 void DescriptorSet::Update(
@@ -86,6 +246,13 @@ void DescriptorSet::Update(
             static_cast<uint32_t>(copies.size()), copies.data());
 }
 
+void DescriptorSet::Update(DescriptorUpdateTemplate* updateTemplate, const void* data)
+{
+    m_device->GetFunctionTable()->
+        vkUpdateDescriptorSetWithTemplate(m_device->GetHandle(), m_handle,
+            updateTemplate->GetHandle(), data);
+}
+
 void DescriptorSet::UpdateBuffers(
     uint32_t binding, uint32_t arrayElement, VkDescriptorType type,
     rad::Span<VkDescriptorBufferInfo> bufferInfos)
@@ -125,7 +292,7 @@ void DescriptorSet::UpdateCombinedImageSamplers(
     write.descriptorCount = static_cast<uint32_t>(imageViews.size());
     write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
-    std::vector<VkDescriptorImageInfo> imageInfos(imageViews.size());
+    rad::SmallVector<VkDescriptorImageInfo, 8> imageInfos(imageViews.size());
     for (size_t i = 0; i < imageViews.size(); i++)
     {
         imageInfos[i].sampler = samplers[i]->GetHandle();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vkpp/Core/Common.h>
+#include <rad/Container/SmallVector.h>
+#include <mutex>
 
 namespace vkpp
 {
@@ -15,16 +17,80 @@ public:
     VKPP_DISABLE_COPY_AND_MOVE(DescriptorPool);
 
     VkDescriptorPool GetHandle() const { return m_handle; }
+    VkDescriptorPoolCreateFlags GetFlags() const { return m_flags; }
 
+    // Allocate, Reset and the release of the sets (freed with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)
+    // are serialized, so that sets can be released from any thread.
+    // Return nullptr if the pool is out of memory (VK_ERROR_OUT_OF_POOL_MEMORY or VK_ERROR_FRAGMENTED_POOL).
     rad::Ref<DescriptorSet> Allocate(DescriptorSetLayout* layout);
+    // All sets allocated become invalid: the DescriptorSet objects that outlive the reset
+    // no longer free their handles.
     void Reset();
 
 private:
+    friend class DescriptorSet;
+    // Free the handle of a set allocated at the reset generation, unless the pool is reset since.
+    void Free(VkDescriptorSet handle, uint64_t resetGeneration);
+
     rad::Ref<Device>        m_device;
     VkDescriptorPool        m_handle = VK_NULL_HANDLE;
+    VkDescriptorPoolCreateFlags m_flags = 0;
+    // The pool must be externally synchronized.
+    std::mutex              m_mutex;
+    // Incremented by each Reset.
+    uint64_t                m_resetGeneration = 0;
 
 }; // class DescriptorPool
 
+// Allocate descriptor sets from a chain of pools, growing on demand (each new pool is twice the size of the last),
+// for sets allocated per frame, draw or dispatch. Pools are recycled as a whole for each frame in flight:
+// ResetFrame resets the pools used by the frame when the GPU has completed it. Thread-safe.
+class DescriptorAllocator : public rad::RefCounted<DescriptorAllocator>
+{
+public:
+    // @param poolSizes: the number of descriptors of each type per set.
+    // @param poolFlags: with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, sets are freed on release,
+    // and the pools exhausted are retried before growing.
+    DescriptorAllocator(
+        rad::Ref<Device> device,
+        rad::Span<VkDescriptorPoolSize> poolSizes,
+        uint32_t frameCount = 1,
+        uint32_t initialSetCount = 64,
+        VkDescriptorPoolCreateFlags poolFlags = 0);
+    ~DescriptorAllocator();
+    VKPP_DISABLE_COPY_AND_MOVE(DescriptorAllocator);
+
+    static constexpr uint32_t MaxSetCountPerPool = 4096;
+
+    uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_frames.size()); }
+    // Sets are allocated from the pools of the frame until the next ResetFrame.
+    void SetFrameIndex(uint32_t frameIndex);
+    // Reset the pools of the frame, whose sets must not be in use by the GPU, and make it current.
+    void ResetFrame(uint32_t frameIndex);
+
+    rad::Ref<DescriptorSet> Allocate(DescriptorSetLayout* layout);
+
+private:
+    rad::Ref<DescriptorPool> CreatePool();
+
+    struct Frame
+    {
+        // The last one is the current pool.
+        std::vector<rad::Ref<DescriptorPool>> pools;
+        // Pools exhausted.
+        std::vector<rad::Ref<DescriptorPool>> fullPools;
+    };
+
+    rad::Ref<Device> m_device;
+    std::vector<VkDescriptorPoolSize> m_poolSizes;
+    VkDescriptorPoolCreateFlags m_poolFlags = 0;
+    uint32_t m_setCountPerPool = 64;
+    std::mutex m_mutex;
+    std::vector<Frame> m_frames;
+    uint32_t m_frameIndex = 0;
+
+}; // class DescriptorAllocator
+
 class DescriptorSetLayout : public rad::RefCounted<DescriptorSetLayout>
 {
 public:
@@ -36,19 +102,46 @@ public:
 
     VkDescriptorSetLayout GetHandle() const { return m_handle; }
 
+    // Layouts created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT (see DescriptorBuffer):
+    // the size of a set in the descriptor buffer, and the offset of the binding in the set.
+    VkDeviceSize GetDescriptorBufferSize() const;
+    VkDeviceSize GetDescriptorBufferBindingOffset(uint32_t binding) const;
+
 private:
     rad::Ref<Device>        m_device;
     VkDescriptorSetLayout   m_handle = VK_NULL_HANDLE;
 
 }; // class DescriptorSetLayout
 
+// Update all descriptors of a set in one call from a packed struct: each entry reads descriptorCount
+// VkDescriptorBufferInfo/VkDescriptorImageInfo/VkBufferView at offset (stride apart) of the data.
+// Created once per layout, much cheaper than building VkWriteDescriptorSet for each update.
+class DescriptorUpdateTemplate : public rad::RefCounted<DescriptorUpdateTemplate>
+{
+public:
+    DescriptorUpdateTemplate(
+        rad::Ref<Device> device,
+        const VkDescriptorUpdateTemplateCreateInfo& createInfo);
+    ~DescriptorUpdateTemplate();
+    VKPP_DISABLE_COPY_AND_MOVE(DescriptorUpdateTemplate);
+
+    VkDescriptorUpdateTemplate GetHandle() const { return m_handle; }
+
+private:
+    rad::Ref<Device>            m_device;
+    VkDescriptorUpdateTemplate  m_handle = VK_NULL_HANDLE;
+
+}; // class DescriptorUpdateTemplate
+
 class DescriptorSet : public rad::RefCounted<DescriptorSet>
 {
 public:
+    // Take the ownership of a set allocated from the pool (see DescriptorPool::Allocate).
     DescriptorSet(
         rad::Ref<Device> device,
         rad::Ref<DescriptorPool> descriptorPool,
-        rad::Ref<DescriptorSetLayout> layout);
+        rad::Ref<DescriptorSetLayout> layout,
+        VkDescriptorSet handle);
     ~DescriptorSet();
     VKPP_DISABLE_COPY_AND_MOVE(DescriptorSet);
 
@@ -56,6 +149,8 @@ public:
 
     void Update(rad::Span<VkWriteDescriptorSet> writes,
         rad::Span<VkCopyDescriptorSet> copies = {});
+    // @param data: the packed struct described by the entries of the template.
+    void Update(DescriptorUpdateTemplate* updateTemplate, const void* data);
     void UpdateBuffers(
         uint32_t binding,
         uint32_t arrayElement,
@@ -89,6 +184,8 @@ private:
     rad::Ref<DescriptorPool>        m_descriptorPool;
     rad::Ref<DescriptorSetLayout>   m_layout;
     VkDescriptorSet                 m_handle = VK_NULL_HANDLE;
+    // The reset generation of the pool at allocation: the handle is gone if the pool is reset since.
+    uint64_t                        m_poolResetGeneration = 0;
 
 }; // class DescriptorSet
 
@@ -105,7 +202,7 @@ inline void DescriptorSet::UpdateSamplers(
     write.descriptorCount = static_cast<uint32_t>(samplers.size());
     write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
 
-    std::vector<VkDescriptorImageInfo> samplerInfos(samplers.size());
+    rad::SmallVector<VkDescriptorImageInfo, 8> samplerInfos(samplers.size());
     for (size_t i = 0; i < samplerInfos.size(); i++)
     {
         samplerInfos[i].sampler = samplers[i]->GetHandle();
@@ -132,7 +229,7 @@ void DescriptorSet::UpdateImages(
     write.descriptorCount = static_cast<uint32_t>(imageViews.size());
     write.descriptorType = type;
 
-    std::vector<VkDescriptorImageInfo> imageInfos(imageViews.size());
+    rad::SmallVector<VkDescriptorImageInfo, 8> imageInfos(imageViews.size());
     for (size_t i = 0; i < imageViews.size(); i++)
     {
         imageInfos[i].sampler = VK_NULL_HANDLE;
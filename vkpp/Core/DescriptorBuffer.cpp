@@ -0,0 +1,155 @@
+#include <vkpp/Core/DescriptorBuffer.h>
+#include <vkpp/Core/PhysicalDevice.h>
+#include <vkpp/Core/Device.h>
+#include <vkpp/Core/Buffer.h>
+#include <vkpp/Core/Image.h>
+#include <vkpp/Core/Sampler.h>
+#include <vkpp/Core/Descriptor.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+DescriptorBuffer::DescriptorBuffer(rad::Ref<Device> device, VkDeviceSize size, VkBufferUsageFlags usage) :
+    m_device(std::move(device)),
+    m_usage(usage)
+{
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage = usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    m_buffer = m_device->CreateBuffer(createInfo, allocInfo);
+    m_mappedData = static_cast<uint8_t*>(m_buffer->GetMappedAddr());
+}
+
+DescriptorBuffer::~DescriptorBuffer()
+{
+}
+
+VkDescriptorBufferBindingInfoEXT DescriptorBuffer::GetBindingInfo() const
+{
+    VkDescriptorBufferBindingInfoEXT bindingInfo = {};
+    bindingInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+    bindingInfo.pNext = nullptr;
+    bindingInfo.address = m_buffer->GetDeviceAddress();
+    bindingInfo.usage = m_usage;
+    return bindingInfo;
+}
+
+VkDeviceSize DescriptorBuffer::AllocateSet(DescriptorSetLayout* layout)
+{
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(
+        m_device->GetPhysicalDevice()->m_descriptorBufferProperties.descriptorBufferOffsetAlignment, 1);
+    const VkDeviceSize setSize = layout->GetDescriptorBufferSize();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const VkDeviceSize offset = (m_allocatedSize + alignment - 1) / alignment * alignment;
+    if (offset + setSize > m_buffer->GetSize())
+    {
+        return InvalidOffset;
+    }
+    m_allocatedSize = offset + setSize;
+    return offset;
+}
+
+void DescriptorBuffer::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_allocatedSize = 0;
+}
+
+void DescriptorBuffer::WriteBuffer(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+    uint32_t binding, uint32_t arrayElement, VkDescriptorType type,
+    VkDeviceAddress address, VkDeviceSize range)
+{
+    VkDescriptorAddressInfoEXT addressInfo = {};
+    addressInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+    addressInfo.pNext = nullptr;
+    addressInfo.address = address;
+    addressInfo.range = range;
+    addressInfo.format = VK_FORMAT_UNDEFINED;
+
+    VkDescriptorGetInfoEXT getInfo = {};
+    getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    getInfo.pNext = nullptr;
+    getInfo.type = type;
+    if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+    {
+        getInfo.data.pUniformBuffer = &addressInfo;
+    }
+    else
+    {
+        assert(type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        getInfo.data.pStorageBuffer = &addressInfo;
+    }
+    Write(setOffset, layout, binding, arrayElement, getInfo);
+}
+
+void DescriptorBuffer::WriteImage(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+    uint32_t binding, uint32_t arrayElement, VkDescriptorType type,
+    ImageView* imageView, VkImageLayout imageLayout, Sampler* sampler)
+{
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler = sampler ? sampler->GetHandle() : VK_NULL_HANDLE;
+    imageInfo.imageView = imageView->GetHandle();
+    imageInfo.imageLayout = imageLayout;
+
+    VkDescriptorGetInfoEXT getInfo = {};
+    getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    getInfo.pNext = nullptr;
+    getInfo.type = type;
+    switch (type)
+    {
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        assert(sampler != nullptr);
+        getInfo.data.pCombinedImageSampler = &imageInfo;
+        break;
+    case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        getInfo.data.pSampledImage = &imageInfo;
+        break;
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        getInfo.data.pStorageImage = &imageInfo;
+        break;
+    case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+        getInfo.data.pInputAttachmentImage = &imageInfo;
+        break;
+    default:
+        assert(false && "DescriptorBuffer::WriteImage: invalid descriptor type!");
+        return;
+    }
+    Write(setOffset, layout, binding, arrayElement, getInfo);
+}
+
+void DescriptorBuffer::WriteSampler(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+    uint32_t binding, uint32_t arrayElement, Sampler* sampler)
+{
+    VkSampler samplerHandle = sampler->GetHandle();
+
+    VkDescriptorGetInfoEXT getInfo = {};
+    getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    getInfo.pNext = nullptr;
+    getInfo.type = VK_DESCRIPTOR_TYPE_SAMPLER;
+    getInfo.data.pSampler = &samplerHandle;
+    Write(setOffset, layout, binding, arrayElement, getInfo);
+}
+
+void DescriptorBuffer::Write(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+    uint32_t binding, uint32_t arrayElement, const VkDescriptorGetInfoEXT& getInfo)
+{
+    const size_t descriptorSize = m_device->GetDescriptorSize(getInfo.type);
+    const VkDeviceSize offset = setOffset +
+        layout->GetDescriptorBufferBindingOffset(binding) + arrayElement * descriptorSize;
+    assert(offset + descriptorSize <= m_buffer->GetSize());
+    m_device->GetFunctionTable()->
+        vkGetDescriptorEXT(m_device->GetHandle(), &getInfo, descriptorSize, m_mappedData + offset);
+    if (!m_buffer->IsHostCoherent())
+    {
+        m_buffer->FlushAllocation(offset, descriptorSize);
+    }
+}
+
+} // namespace vkpp
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vkpp/Core/Common.h>
+#include <mutex>
+
+namespace vkpp
+{
+
+// Descriptors written directly into a host visible buffer (VK_EXT_descriptor_buffer),
+// bound by device address with CommandBuffer::BindDescriptorBuffers/SetDescriptorBufferOffsets:
+// no pool and no descriptor set object, a set is a range of the buffer at an offset.
+// Layouts must be created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT,
+// and pipelines with VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT.
+// Descriptors can be written at any time (partial updates of large tables),
+// but not while the GPU may read them.
+class DescriptorBuffer : public rad::RefCounted<DescriptorBuffer>
+{
+public:
+    static constexpr VkDeviceSize InvalidOffset = ~VkDeviceSize(0);
+
+    // @param usage: VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT and/or
+    // VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT (for samplers and combined image samplers).
+    DescriptorBuffer(rad::Ref<Device> device, VkDeviceSize size, VkBufferUsageFlags usage);
+    ~DescriptorBuffer();
+    VKPP_DISABLE_COPY_AND_MOVE(DescriptorBuffer);
+
+    Buffer* GetBuffer() const { return m_buffer.get(); }
+    VkBufferUsageFlags GetUsage() const { return m_usage; }
+    VkDescriptorBufferBindingInfoEXT GetBindingInfo() const;
+
+    // Allocate the range of a set of the layout; return its offset, or InvalidOffset if the buffer is full.
+    VkDeviceSize AllocateSet(DescriptorSetLayout* layout);
+    // The sets allocated become invalid.
+    void Reset();
+
+    // Write the descriptors of the binding of the set at setOffset (returned by AllocateSet).
+    // @param type: uniform or storage buffer.
+    void WriteBuffer(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+        uint32_t binding, uint32_t arrayElement, VkDescriptorType type,
+        VkDeviceAddress address, VkDeviceSize range);
+    // @param type: sampled/storage image, input attachment, or combined image sampler (with the sampler).
+    void WriteImage(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+        uint32_t binding, uint32_t arrayElement, VkDescriptorType type,
+        ImageView* imageView, VkImageLayout imageLayout, Sampler* sampler = nullptr);
+    void WriteSampler(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+        uint32_t binding, uint32_t arrayElement, Sampler* sampler);
+
+private:
+    void Write(VkDeviceSize setOffset, DescriptorSetLayout* layout,
+        uint32_t binding, uint32_t arrayElement, const VkDescriptorGetInfoEXT& getInfo);
+
+    rad::Ref<Device> m_device;
+    rad::Ref<Buffer> m_buffer;
+    VkBufferUsageFlags m_usage = 0;
+    uint8_t* m_mappedData = nullptr;
+    std::mutex m_mutex;
+    VkDeviceSize m_allocatedSize = 0;
+
+}; // class DescriptorBuffer
+
+} // namespace vkpp
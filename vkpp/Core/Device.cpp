@@ -6,6 +6,7 @@
 #include <vkpp/Core/Fence.h>
 #include <vkpp/Core/Semaphore.h>
 #include <vkpp/Core/Event.h>
+#include <vkpp/Core/QueryPool.h>
 #include <vkpp/Core/RenderPass.h>
 #include <vkpp/Core/Framebuffer.h>
 #include <vkpp/Core/Pipeline.h>
@@ -13,9 +14,12 @@
 #include <vkpp/Core/Image.h>
 #include <vkpp/Core/Sampler.h>
 #include <vkpp/Core/Descriptor.h>
+#include <vkpp/Core/DescriptorBuffer.h>
 #include <vkpp/Core/Surface.h>
 #include <vkpp/Core/Swapchain.h>
 
+#include <algorithm>
+
 namespace vkpp
 {
 
@@ -40,7 +44,13 @@ Device::Device(
         m_physicalDevice->m_queueFamilies;
     std::vector<uint32_t> computeFamilyIndices;
     std::vector<VkDeviceQueueCreateInfo> queueInfos;
-    float queuePriorities[1] = { 1.0f };
+    uint32_t maxQueueCount = 1;
+    for (const VkQueueFamilyProperties& props : queueFamilyProps)
+    {
+        maxQueueCount = std::max(maxQueueCount, props.queueCount);
+    }
+    std::vector<float> queuePriorities(maxQueueCount, 1.0f);
+    m_queueCounts.resize(queueFamilyProps.size(), 1);
     for (uint32_t i = 0; i < queueFamilyProps.size(); ++i)
     {
         VKPP_LOG(info, "QueueFamily#{}: {}", i,
@@ -85,8 +95,14 @@ Device::Device(
         queueInfo.pNext = nullptr;
         queueInfo.flags = 0;
         queueInfo.queueFamilyIndex = i;
-        queueInfo.queueCount = 1;
-        queueInfo.pQueuePriorities = queuePriorities;
+        // Create every queue of the families that support compute, so that independent work
+        // can run concurrently on the async compute queues (see ComputeScheduler).
+        if (rad::HasBits<uint32_t>(queueFlags, VK_QUEUE_COMPUTE_BIT))
+        {
+            m_queueCounts[i] = std::max(queueFamilyProps[i].queueCount, 1u);
+        }
+        queueInfo.queueCount = m_queueCounts[i];
+        queueInfo.pQueuePriorities = queuePriorities.data();
         queueInfos.push_back(queueInfo);
     }
 
@@ -144,13 +160,34 @@ Device::Device(
         vmaFunctions.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
         vmaFunctions.vkGetDeviceProcAddr = vkGetDeviceProcAddr;
         allocatorCreateInfo.pVulkanFunctions = &vmaFunctions;
-        if (m_physicalDevice->m_vk12Features.bufferDeviceAddress)
+        if (IsBufferDeviceAddressSupported())
         {
             allocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
         }
+        if (IsMemoryBudgetSupported())
+        {
+            allocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        }
         VK_CHECK(vmaCreateAllocator(&allocatorCreateInfo, &m_allocator));
     }
 
+    // Without resizable BAR, the host visible window of device local memory is only 256MB,
+    // too small to hold device buffers.
+    const VkDeviceSize barSizeThreshold = VkDeviceSize(256) << 20;
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = m_physicalDevice->m_memoryProperties;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        const VkMemoryType& memoryType = memoryProperties.memoryTypes[i];
+        if (rad::HasBits<uint32_t>(memoryType.propertyFlags,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+            (memoryProperties.memoryHeaps[memoryType.heapIndex].size > barSizeThreshold))
+        {
+            m_isDeviceMemoryHostVisible = true;
+            break;
+        }
+    }
+    m_isDirectUploadEnabled = m_isDeviceMemoryHostVisible;
+
     VKPP_LOG(info, "Vulkan device created on \"{}\"",
         m_physicalDevice->GetDeviceName());
 }
@@ -184,6 +221,226 @@ bool Device::IsExtensionSupported(std::string_view extension)
     return m_enabledExtensionNames.contains(extension);
 }
 
+bool Device::IsBufferDeviceAddressSupported() const
+{
+    return (m_physicalDevice->m_vk12Features.bufferDeviceAddress == VK_TRUE);
+}
+
+bool Device::IsTimelineSemaphoreSupported() const
+{
+    return (m_physicalDevice->m_vk12Features.timelineSemaphore == VK_TRUE);
+}
+
+bool Device::IsPushDescriptorSupported() const
+{
+    return m_enabledExtensionNames.contains("VK_KHR_push_descriptor");
+}
+
+bool Device::IsDescriptorBufferSupported() const
+{
+    return m_enabledExtensionNames.contains("VK_EXT_descriptor_buffer") &&
+        (m_physicalDevice->m_descriptorBufferFeatures.descriptorBuffer == VK_TRUE);
+}
+
+bool Device::IsBindlessTextureSupported() const
+{
+    const VkPhysicalDeviceVulkan12Features& features = m_physicalDevice->m_vk12Features;
+    return (features.descriptorBindingPartiallyBound == VK_TRUE) &&
+        (features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE) &&
+        (features.descriptorBindingUpdateUnusedWhilePending == VK_TRUE) &&
+        (features.runtimeDescriptorArray == VK_TRUE) &&
+        (features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE);
+}
+
+bool Device::IsMemoryBudgetSupported() const
+{
+    return m_enabledExtensionNames.contains("VK_EXT_memory_budget");
+}
+
+std::vector<VmaBudget> Device::GetHeapBudgets() const
+{
+    std::vector<VmaBudget> budgets(m_physicalDevice->m_memoryProperties.memoryHeapCount);
+    vmaGetHeapBudgets(m_allocator, budgets.data());
+    return budgets;
+}
+
+bool Device::IsSparseBufferSupported() const
+{
+    const VkPhysicalDeviceFeatures& features = m_physicalDevice->m_features;
+    return (features.sparseBinding == VK_TRUE) && (features.sparseResidencyBuffer == VK_TRUE);
+}
+
+float Device::GetFragmentation() const
+{
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = m_physicalDevice->m_memoryProperties;
+    // Free space at the end of a block is a free range too: a single block is not fragmented,
+    // half-used blocks are (their allocations can be packed to free blocks).
+    VmaTotalStatistics statistics = {};
+    vmaCalculateStatistics(m_allocator, &statistics);
+    VkDeviceSize freeBytes = 0;
+    VkDeviceSize largestFreeRange = 0;
+    for (uint32_t heapIndex = 0; heapIndex < memoryProperties.memoryHeapCount; ++heapIndex)
+    {
+        if (rad::HasBits<uint32_t>(memoryProperties.memoryHeaps[heapIndex].flags,
+            VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+        {
+            const VmaDetailedStatistics& heapStatistics = statistics.memoryHeap[heapIndex];
+            freeBytes += heapStatistics.statistics.blockBytes - heapStatistics.statistics.allocationBytes;
+            if (heapStatistics.unusedRangeCount > 0)
+            {
+                largestFreeRange = std::max(largestFreeRange, heapStatistics.unusedRangeSizeMax);
+            }
+        }
+    }
+    if (freeBytes == 0)
+    {
+        return 0.0f;
+    }
+    return 1.0f - float(double(std::min(largestFreeRange, freeBytes)) / double(freeBytes));
+}
+
+std::vector<rad::Ref<Buffer>> Device::Defragment(Queue* queue, VkDeviceSize maxBytesPerPass)
+{
+    VmaDefragmentationInfo defragInfo = {};
+    defragInfo.flags = 0;
+    defragInfo.pool = nullptr;
+    defragInfo.maxBytesPerPass = maxBytesPerPass;
+    defragInfo.maxAllocationsPerPass = 0;
+    VmaDefragmentationContext defragContext = nullptr;
+    VK_CHECK(vmaBeginDefragmentation(m_allocator, &defragInfo, &defragContext));
+
+    rad::Ref<CommandPool> cmdPool =
+        CreateCommandPool(queue->GetQueueFamily(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    struct PendingMove
+    {
+        Buffer* buffer;
+        VkBuffer newHandle;
+    };
+    std::vector<PendingMove> pendingMoves;
+    std::vector<rad::Ref<Buffer>> movedBuffers;
+    while (true)
+    {
+        VmaDefragmentationPassMoveInfo passInfo = {};
+        VkResult passResult = vmaBeginDefragmentationPass(m_allocator, defragContext, &passInfo);
+        if (passResult != VK_INCOMPLETE)
+        {
+            VK_CHECK(passResult);
+            break;
+        }
+
+        pendingMoves.clear();
+        for (uint32_t i = 0; i < passInfo.moveCount; ++i)
+        {
+            VmaDefragmentationMove& move = passInfo.pMoves[i];
+            VmaAllocationInfo allocInfo = {};
+            vmaGetAllocationInfo(m_allocator, move.srcAllocation, &allocInfo);
+            Buffer* buffer = static_cast<Buffer*>(allocInfo.pUserData);
+            if (!buffer || !buffer->IsMovable())
+            {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+            VkBufferCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.size = buffer->GetSize();
+            createInfo.usage = buffer->GetUsage();
+            createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            VkBuffer newHandle = VK_NULL_HANDLE;
+            VK_CHECK(m_functionTable.vkCreateBuffer(m_handle, &createInfo, nullptr, &newHandle));
+            VK_CHECK(vmaBindBufferMemory(m_allocator, move.dstTmpAllocation, newHandle));
+            pendingMoves.push_back({ buffer, newHandle });
+        }
+
+        if (!pendingMoves.empty())
+        {
+            rad::Ref<CommandBuffer> cmdBuffer = cmdPool->Allocate();
+            cmdBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+            VkMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.pNext = nullptr;
+            barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            cmdBuffer->SetPipelineBarrier(
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                barrier, {}, {});
+            for (const PendingMove& pendingMove : pendingMoves)
+            {
+                VkBufferCopy region = {};
+                region.srcOffset = 0;
+                region.dstOffset = 0;
+                region.size = pendingMove.buffer->GetSize();
+                m_functionTable.vkCmdCopyBuffer(cmdBuffer->GetHandle(),
+                    pendingMove.buffer->GetHandle(), pendingMove.newHandle, 1, &region);
+            }
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            cmdBuffer->SetPipelineBarrier(
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                barrier, {}, {});
+            cmdBuffer->End();
+            queue->SubmitAndWait(cmdBuffer.get());
+        }
+
+        // The source allocations now refer to the new memory: switch the buffers to the new handles.
+        passResult = vmaEndDefragmentationPass(m_allocator, defragContext, &passInfo);
+        for (const PendingMove& pendingMove : pendingMoves)
+        {
+            pendingMove.buffer->ReplaceHandle(pendingMove.newHandle);
+            movedBuffers.push_back(pendingMove.buffer);
+        }
+        if (passResult != VK_INCOMPLETE)
+        {
+            VK_CHECK(passResult);
+            break;
+        }
+    }
+
+    VmaDefragmentationStats stats = {};
+    vmaEndDefragmentation(m_allocator, defragContext, &stats);
+    VKPP_LOG(info, "Device::Defragment: {} bytes moved ({} allocations), {} bytes freed ({} memory blocks).",
+        stats.bytesMoved, stats.allocationsMoved, stats.bytesFreed, stats.deviceMemoryBlocksFreed);
+    return movedBuffers;
+}
+
+size_t Device::GetDescriptorSize(VkDescriptorType type) const
+{
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties =
+        m_physicalDevice->m_descriptorBufferProperties;
+    // Robust buffer access can make buffer descriptors larger.
+    const bool robust = (m_physicalDevice->m_features.robustBufferAccess == VK_TRUE);
+    switch (type)
+    {
+    case VK_DESCRIPTOR_TYPE_SAMPLER:
+        return properties.samplerDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        return properties.combinedImageSamplerDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        return properties.sampledImageDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        return properties.storageImageDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        return robust ? properties.robustUniformTexelBufferDescriptorSize :
+            properties.uniformTexelBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+        return robust ? properties.robustStorageTexelBufferDescriptorSize :
+            properties.storageTexelBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        return robust ? properties.robustUniformBufferDescriptorSize :
+            properties.uniformBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        return robust ? properties.robustStorageBufferDescriptorSize :
+            properties.storageBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+        return properties.inputAttachmentDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+        return properties.accelerationStructureDescriptorSize;
+    default:
+        return 0;
+    }
+}
+
 bool Device::IsQueueFamilySupported(QueueFamily queueFamily) const
 {
     return (GetQueueFamilyIndex(queueFamily) != VK_QUEUE_FAMILY_IGNORED);
@@ -194,9 +451,25 @@ uint32_t Device::GetQueueFamilyIndex(QueueFamily queueFamily) const
     return m_queueFamilyIndexTable[queueFamily];
 }
 
-rad::Ref<Queue> Device::CreateQueue(QueueFamily queueFamily)
+uint32_t Device::GetQueueCount(QueueFamily queueFamily) const
+{
+    uint32_t queueFamilyIndex = GetQueueFamilyIndex(queueFamily);
+    if (queueFamilyIndex == VK_QUEUE_FAMILY_IGNORED)
+    {
+        return 0;
+    }
+    return m_queueCounts[queueFamilyIndex];
+}
+
+rad::Ref<Queue> Device::CreateQueue(QueueFamily queueFamily, uint32_t queueIndex)
 {
-    return RAD_NEW Queue(this, queueFamily);
+    if (queueIndex >= GetQueueCount(queueFamily))
+    {
+        VKPP_LOG(err, "Device::CreateQueue: queue index {} is out of range (queueCount={})!",
+            queueIndex, GetQueueCount(queueFamily));
+        return nullptr;
+    }
+    return RAD_NEW Queue(this, queueFamily, queueIndex);
 }
 
 bool Device::IsSurfaceSupported(QueueFamily queueFamily, Surface* surface)
@@ -241,6 +514,21 @@ rad::Ref<Semaphore> Device::CreateSemaphoreSignaled()
     return CreateSemaphore(VK_FENCE_CREATE_SIGNALED_BIT);
 }
 
+rad::Ref<Semaphore> Device::CreateTimelineSemaphore(uint64_t initialValue)
+{
+    VkSemaphoreTypeCreateInfo typeInfo = {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.pNext = nullptr;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = initialValue;
+
+    VkSemaphoreCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    createInfo.pNext = &typeInfo;
+    createInfo.flags = 0; // reserved for future use
+    return RAD_NEW Semaphore(this, createInfo);
+}
+
 rad::Ref<Event> Device::CreateEvent()
 {
     VkEventCreateInfo createInfo = {};
@@ -250,6 +538,18 @@ rad::Ref<Event> Device::CreateEvent()
     return RAD_NEW Event(this, createInfo);
 }
 
+rad::Ref<QueryPool> Device::CreateQueryPool(VkQueryType queryType, uint32_t queryCount)
+{
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0; // reserved for future use
+    createInfo.queryType = queryType;
+    createInfo.queryCount = queryCount;
+    createInfo.pipelineStatistics = 0;
+    return RAD_NEW QueryPool(this, createInfo);
+}
+
 void Device::WaitIdle()
 {
     VK_CHECK(GetFunctionTable()->vkDeviceWaitIdle(m_handle));
@@ -357,12 +657,57 @@ rad::Ref<Buffer> Device::CreateUniformBuffer(
     return CreateBuffer(createInfo, allocInfo);
 }
 
-rad::Ref<Buffer> Device::CreateStagingBuffer(VkDeviceSize size)
+rad::Ref<Buffer> Device::CreateStagingBuffer(VkDeviceSize size, bool isPersistentMapped)
 {
-    VkBufferUsageFlags usage =
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage =
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
         VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    return CreateBuffer(size, usage, VMA_MEMORY_USAGE_CPU_ONLY);
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    if (isPersistentMapped)
+    {
+        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    }
+    return CreateBuffer(createInfo, allocInfo);
+}
+
+rad::Ref<Buffer> Device::CreateReadbackBuffer(VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags =
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT |
+        VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    // Uncached (write-combined) memory is several times slower to read.
+    allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    return CreateBuffer(createInfo, allocInfo);
+}
+
+VmaAllocationCreateInfo Device::GetDeviceBufferAllocInfo() const
+{
+    VmaAllocationCreateInfo allocInfo = {};
+    if (m_isDirectUploadEnabled)
+    {
+        // Host visible device local memory if available, device local memory (uploaded by transfer) otherwise.
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        allocInfo.flags =
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+            VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    }
+    else
+    {
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    }
+    return allocInfo;
 }
 
 rad::Ref<Buffer> Device::CreateStorageBuffer(VkDeviceSize size)
@@ -374,27 +719,53 @@ rad::Ref<Buffer> Device::CreateStorageBuffer(VkDeviceSize size)
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
         VK_BUFFER_USAGE_TRANSFER_DST_BIT |
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-    VmaAllocationCreateInfo allocInfo = {};
-    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    return RAD_NEW Buffer(this, createInfo, allocInfo);
+    // Kernels can take the buffers by address instead of descriptors.
+    if (IsBufferDeviceAddressSupported())
+    {
+        createInfo.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+    return RAD_NEW Buffer(this, createInfo, GetDeviceBufferAllocInfo());
+}
+
+rad::Ref<Buffer> Device::CreateSparseStorageBuffer(VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.flags = VK_BUFFER_CREATE_SPARSE_BINDING_BIT | VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT;
+    createInfo.size = size;
+    createInfo.usage =
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (IsBufferDeviceAddressSupported())
+    {
+        createInfo.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+    return RAD_NEW Buffer(this, createInfo);
 }
 
 rad::Ref<Buffer> Device::CreateVertexBuffer(VkDeviceSize size)
 {
-    VkBufferUsageFlags usage =
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage =
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
         VK_BUFFER_USAGE_TRANSFER_DST_BIT |
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-    return CreateBuffer(size, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+    return CreateBuffer(createInfo, GetDeviceBufferAllocInfo());
 }
 
 rad::Ref<Buffer> Device::CreateIndexBuffer(VkDeviceSize size)
 {
-    VkBufferUsageFlags usage =
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage =
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
         VK_BUFFER_USAGE_TRANSFER_DST_BIT |
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-    return CreateBuffer(size, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+    return CreateBuffer(createInfo, GetDeviceBufferAllocInfo());
 }
 
 rad::Ref<Image> Device::CreateImage(
@@ -540,12 +911,20 @@ rad::Ref<Sampler> Device::CreatSamplerLinear(
 
 rad::Ref<DescriptorSetLayout>
 Device::CreateDescriptorSetLayout(
-    rad::Span<VkDescriptorSetLayoutBinding> layoutBindings)
+    const VkDescriptorSetLayoutCreateInfo& createInfo)
+{
+    return RAD_NEW DescriptorSetLayout(this, createInfo);
+}
+
+rad::Ref<DescriptorSetLayout>
+Device::CreateDescriptorSetLayout(
+    rad::Span<VkDescriptorSetLayoutBinding> layoutBindings,
+    VkDescriptorSetLayoutCreateFlags flags)
 {
     VkDescriptorSetLayoutCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     createInfo.pNext = nullptr;
-    createInfo.flags = 0;
+    createInfo.flags = flags;
     createInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
     createInfo.pBindings = layoutBindings.data();
 
@@ -595,4 +974,52 @@ rad::Ref<DescriptorPool> Device::CreateDescriptorPool(
     return CreateDescriptorPool(createInfo);
 }
 
+rad::Ref<DescriptorBuffer> Device::CreateDescriptorBuffer(
+    VkDeviceSize size, VkBufferUsageFlags usage)
+{
+    return RAD_NEW DescriptorBuffer(this, size, usage);
+}
+
+rad::Ref<DescriptorUpdateTemplate> Device::CreateDescriptorUpdateTemplate(
+    const VkDescriptorUpdateTemplateCreateInfo& createInfo)
+{
+    return RAD_NEW DescriptorUpdateTemplate(this, createInfo);
+}
+
+rad::Ref<DescriptorUpdateTemplate> Device::CreateDescriptorUpdateTemplate(
+    DescriptorSetLayout* layout, rad::Span<VkDescriptorUpdateTemplateEntry> entries)
+{
+    VkDescriptorUpdateTemplateCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0; // reserved for future use
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    createInfo.descriptorSetLayout = layout->GetHandle();
+    // Ignored for VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET.
+    createInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+    createInfo.pipelineLayout = VK_NULL_HANDLE;
+    createInfo.set = 0;
+    return CreateDescriptorUpdateTemplate(createInfo);
+}
+
+rad::Ref<DescriptorUpdateTemplate> Device::CreatePushDescriptorUpdateTemplate(
+    VkPipelineBindPoint bindPoint, PipelineLayout* layout, uint32_t set,
+    rad::Span<VkDescriptorUpdateTemplateEntry> entries)
+{
+    VkDescriptorUpdateTemplateCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0; // reserved for future use
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+    createInfo.descriptorSetLayout = VK_NULL_HANDLE; // ignored for push descriptors
+    createInfo.pipelineBindPoint = bindPoint;
+    createInfo.pipelineLayout = layout->GetHandle();
+    createInfo.set = set;
+    return CreateDescriptorUpdateTemplate(createInfo);
+}
+
 } // namespace vkpp
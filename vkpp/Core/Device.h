@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vkpp/Core/Common.h>
+#include <atomic>
 
 namespace vkpp
 {
@@ -24,10 +25,53 @@ public:
     const VkPhysicalDeviceLimits& GetLimits() const;
 
     bool IsExtensionSupported(std::string_view extension);
+    // Buffers can be accessed by shaders through their device address (Vulkan 1.2 bufferDeviceAddress).
+    bool IsBufferDeviceAddressSupported() const;
+    // Semaphores with a 64-bit counter (Vulkan 1.2 timelineSemaphore), see CreateTimelineSemaphore.
+    bool IsTimelineSemaphoreSupported() const;
+    // VK_KHR_push_descriptor: descriptors recorded in command buffers, see CommandBuffer::PushDescriptorSet.
+    bool IsPushDescriptorSupported() const;
+    // VK_EXT_descriptor_buffer: descriptors written into buffers, see DescriptorBuffer.
+    bool IsDescriptorBufferSupported() const;
+    // Sampled image arrays can be partially bound and updated after bind, including while the set is used
+    // by pending commands (Vulkan 1.2 descriptor indexing), see BindlessTextureTable.
+    bool IsBindlessTextureSupported() const;
+    // Size in bytes of a descriptor of the type in descriptor buffers.
+    size_t GetDescriptorSize(VkDescriptorType type) const;
+    // Most of the device local memory is host visible: resizable BAR, or unified memory
+    // (integrated and software devices).
+    bool IsDeviceMemoryHostVisible() const { return m_isDeviceMemoryHostVisible; }
+    // Allocation policy of device buffers (vertex, index and storage buffers): if enabled, they are allocated
+    // in host visible device local memory when available, and written directly by the host
+    // (Context::WriteBuffer) instead of through a staging buffer. Enabled if IsDeviceMemoryHostVisible.
+    void SetDirectUploadEnabled(bool enabled) { m_isDirectUploadEnabled = enabled; }
+    bool IsDirectUploadEnabled() const { return m_isDirectUploadEnabled; }
+    // VK_EXT_memory_budget: the usage and budget of heaps are reported by the driver,
+    // including other processes; otherwise estimated from the allocations of this device.
+    bool IsMemoryBudgetSupported() const;
+    // Usage and budget of each memory heap (indexed by heap index), see ResidencyManager.
+    std::vector<VmaBudget> GetHeapBudgets() const;
+    // Buffers can be partially resident (sparseBinding and sparseResidencyBuffer), see CreateSparseStorageBuffer.
+    bool IsSparseBufferSupported() const;
+    // Fragmentation of the free memory of the device local heaps, from 0 (all free ranges could hold
+    // a single allocation) to 1: 1 - (largest free range / free bytes), over the memory blocks of VMA.
+    float GetFragmentation() const;
+    // The buffers that Defragment can move (Buffer::IsMovable): nothing to move if 0.
+    uint32_t GetMovableBufferCount() const { return m_movableBufferCount.load(); }
+    // Compact the device local memory (VMA defragmentation): buffer allocations are moved by copies
+    // submitted to the queue, pass by pass (at most maxBytesPerPass each, 0 for no limit).
+    // Buffer objects are updated in place (handle and device address), so the objects that own them
+    // need no change, but descriptors written with the old handles must be rewritten: the buffers moved
+    // are returned. Only movable buffers (Buffer::IsMovable) are moved, images are not.
+    // Mapped buffers are moved too, their mapped addresses change.
+    // The buffers must not be in use by the device.
+    std::vector<rad::Ref<Buffer>> Defragment(Queue* queue, VkDeviceSize maxBytesPerPass = 0);
 
     bool IsQueueFamilySupported(QueueFamily queueFamily) const;
     uint32_t GetQueueFamilyIndex(QueueFamily queueFamily) const;
-    rad::Ref<Queue> CreateQueue(QueueFamily queueFamily);
+    // All queues of the families that support compute are created, one queue of the others.
+    uint32_t GetQueueCount(QueueFamily queueFamily) const;
+    rad::Ref<Queue> CreateQueue(QueueFamily queueFamily, uint32_t queueIndex = 0);
     bool IsSurfaceSupported(QueueFamily queueFamily, Surface* surface);
 
     rad::Ref<CommandPool> CreateCommandPool(
@@ -38,9 +82,13 @@ public:
     rad::Ref<Fence> CreateFence(VkFenceCreateFlags flags = 0);
     rad::Ref<Semaphore> CreateSemaphore(VkSemaphoreCreateFlags flags = 0);
     rad::Ref<Semaphore> CreateSemaphoreSignaled();
+    rad::Ref<Semaphore> CreateTimelineSemaphore(uint64_t initialValue = 0);
     rad::Ref<Event> CreateEvent();
     void WaitIdle();
 
+    // Queries
+    rad::Ref<QueryPool> CreateQueryPool(VkQueryType queryType, uint32_t queryCount);
+
     // RenderPass
     rad::Ref<RenderPass> CreateRenderPass(const VkRenderPassCreateInfo& createInfo);
     rad::Ref<Framebuffer> CreateFramebuffer(
@@ -69,8 +117,13 @@ public:
         VkBufferUsageFlags usage,
         VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_AUTO);
     rad::Ref<Buffer> CreateUniformBuffer(VkDeviceSize size, bool isPersistentMapped = false);
-    rad::Ref<Buffer> CreateStagingBuffer(VkDeviceSize size);
+    // Upload: write-combined host memory, fast to write but slow to read by the host.
+    rad::Ref<Buffer> CreateStagingBuffer(VkDeviceSize size, bool isPersistentMapped = false);
+    // Download (copy destination): host cached memory if available, for fast reads by the host.
+    rad::Ref<Buffer> CreateReadbackBuffer(VkDeviceSize size);
     rad::Ref<Buffer> CreateStorageBuffer(VkDeviceSize size);
+    // Sparse storage buffer whose memory is committed by pages (Buffer::GetPageTable).
+    rad::Ref<Buffer> CreateSparseStorageBuffer(VkDeviceSize size);
     rad::Ref<Buffer> CreateVertexBuffer(VkDeviceSize size);
     rad::Ref<Buffer> CreateIndexBuffer(VkDeviceSize size);
 
@@ -100,7 +153,10 @@ public:
 
     // Resource Binding
     rad::Ref<DescriptorSetLayout> CreateDescriptorSetLayout(
-        rad::Span<VkDescriptorSetLayoutBinding> layoutBindings);
+        const VkDescriptorSetLayoutCreateInfo& createInfo);
+    rad::Ref<DescriptorSetLayout> CreateDescriptorSetLayout(
+        rad::Span<VkDescriptorSetLayoutBinding> layoutBindings,
+        VkDescriptorSetLayoutCreateFlags flags = 0);
     rad::Ref<PipelineLayout> CreatePipelineLayout(
         rad::Span<DescriptorSetLayout*> descSetLayouts,
         rad::Span<VkPushConstantRange> pushConstantRanges = {});
@@ -108,16 +164,39 @@ public:
         const VkDescriptorPoolCreateInfo& createInfo);
     rad::Ref<DescriptorPool> CreateDescriptorPool(
         uint32_t maxSets, rad::Span<VkDescriptorPoolSize> poolSizes);
+    rad::Ref<DescriptorBuffer> CreateDescriptorBuffer(
+        VkDeviceSize size,
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT);
+    rad::Ref<DescriptorUpdateTemplate> CreateDescriptorUpdateTemplate(
+        const VkDescriptorUpdateTemplateCreateInfo& createInfo);
+    // Template to update the sets of the layout (VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET).
+    rad::Ref<DescriptorUpdateTemplate> CreateDescriptorUpdateTemplate(
+        DescriptorSetLayout* layout, rad::Span<VkDescriptorUpdateTemplateEntry> entries);
+    // Template to push the descriptors of the set of the pipeline layout
+    // (VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR).
+    rad::Ref<DescriptorUpdateTemplate> CreatePushDescriptorUpdateTemplate(
+        VkPipelineBindPoint bindPoint, PipelineLayout* layout, uint32_t set,
+        rad::Span<VkDescriptorUpdateTemplateEntry> entries);
 
 private:
+    // Allocation of device buffers, according to the direct upload policy.
+    VmaAllocationCreateInfo GetDeviceBufferAllocInfo() const;
+
     rad::Ref<Instance> m_instance;
     rad::Ref<PhysicalDevice> m_physicalDevice;
     VkDevice m_handle = VK_NULL_HANDLE;
     // Map QueueFamily to the real queue family index.
     uint32_t m_queueFamilyIndexTable[QueueFamilyCount];
+    // Number of queues created of each queue family index.
+    std::vector<uint32_t> m_queueCounts;
     std::set<std::string, rad::StringLess> m_enabledExtensionNames;
     VolkDeviceTable m_functionTable = {};
     VmaAllocator m_allocator = nullptr;
+    bool m_isDeviceMemoryHostVisible = false;
+    bool m_isDirectUploadEnabled = false;
+    // Counted by Buffer.
+    friend class Buffer;
+    std::atomic<uint32_t> m_movableBufferCount = 0;
 
 }; // class Device
 
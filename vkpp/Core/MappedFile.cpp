@@ -0,0 +1,139 @@
+#include <vkpp/Core/MappedFile.h>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vkpp
+{
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(std::string_view fileName)
+{
+    Close();
+
+    std::string path(fileName);
+    HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        VKPP_LOG(err, "MappedFile: failed to open \"{}\".", fileName);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || (fileSize.QuadPart == 0))
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        VKPP_LOG(err, "MappedFile: CreateFileMapping failed for \"{}\".", fileName);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        VKPP_LOG(err, "MappedFile: MapViewOfFile failed for \"{}\".", fileName);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    m_fileHandle = fileHandle;
+    m_mappingHandle = mappingHandle;
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = static_cast<uint64_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mappingHandle)
+    {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle)
+    {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+    m_size = 0;
+}
+
+#else
+
+bool MappedFile::Open(std::string_view fileName)
+{
+    Close();
+
+    std::string path(fileName);
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        VKPP_LOG(err, "MappedFile: failed to open \"{}\".", fileName);
+        return false;
+    }
+
+    struct stat fileStat = {};
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size == 0))
+    {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps a reference to the file.
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        VKPP_LOG(err, "MappedFile: mmap failed for \"{}\".", fileName);
+        return false;
+    }
+    // The file is expected to be consumed front to back.
+    madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = static_cast<uint64_t>(fileStat.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+    {
+        munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+        m_data = nullptr;
+    }
+    m_size = 0;
+}
+
+#endif
+
+} // namespace vkpp
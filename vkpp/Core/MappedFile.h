@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vkpp/Core/Common.h>
+
+namespace vkpp
+{
+
+// Read-only memory mapping of a whole file.
+class MappedFile : public rad::RefCounted<MappedFile>
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    VKPP_DISABLE_COPY_AND_MOVE(MappedFile);
+
+    bool Open(std::string_view fileName);
+    void Close();
+
+    bool IsOpen() const { return (m_data != nullptr); }
+    const uint8_t* GetData() const { return m_data; }
+    uint64_t GetSize() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    uint64_t m_size = 0;
+#if defined(_WIN32)
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+
+}; // class MappedFile
+
+} // namespace vkpp
@@ -11,6 +11,16 @@ PhysicalDevice::PhysicalDevice(rad::Ref<Instance> instance, VkPhysicalDevice han
 {
     m_properties = {};
     vkGetPhysicalDeviceProperties(m_handle, &m_properties);
+
+    // Extension structures are chained only if supported.
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(m_handle, nullptr, &extensionCount, nullptr);
+    if (extensionCount > 0)
+    {
+        m_extensions.resize(extensionCount);
+        vkEnumerateDeviceExtensionProperties(m_handle, nullptr, &extensionCount, m_extensions.data());
+    }
+
     if (IsVersionMatchOrGreater(1, 1, 0))
     {
         m_properties2 = {};
@@ -34,6 +44,12 @@ PhysicalDevice::PhysicalDevice(rad::Ref<Instance> instance, VkPhysicalDevice han
             m_vk13Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES;
             VK_STRUCTURE_CHAIN_ADD(m_properties2, m_vk13Properties);
         }
+        if (IsExtensionSupported(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME))
+        {
+            m_descriptorBufferProperties = {};
+            m_descriptorBufferProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+            VK_STRUCTURE_CHAIN_ADD(m_properties2, m_descriptorBufferProperties);
+        }
         VK_STRUCTURE_CHAIN_END(m_properties2);
         vkGetPhysicalDeviceProperties2(m_handle, &m_properties2);
     }
@@ -49,14 +65,6 @@ PhysicalDevice::PhysicalDevice(rad::Ref<Instance> instance, VkPhysicalDevice han
 
     vkGetPhysicalDeviceMemoryProperties(m_handle, &m_memoryProperties);
 
-    uint32_t extensionCount = 0;
-    vkEnumerateDeviceExtensionProperties(m_handle, nullptr, &extensionCount, nullptr);
-    if (extensionCount > 0)
-    {
-        m_extensions.resize(extensionCount);
-        vkEnumerateDeviceExtensionProperties(m_handle, nullptr, &extensionCount, m_extensions.data());
-    }
-
     m_features = {};
     vkGetPhysicalDeviceFeatures(m_handle, &m_features);
     if (IsVersionMatchOrGreater(1, 1, 0))
@@ -88,6 +96,12 @@ PhysicalDevice::PhysicalDevice(rad::Ref<Instance> instance, VkPhysicalDevice han
             m_barycentricFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADER_BARYCENTRIC_FEATURES_KHR;
             VK_STRUCTURE_CHAIN_ADD(m_features2, m_barycentricFeatures);
         }
+        if (IsExtensionSupported(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME))
+        {
+            m_descriptorBufferFeatures = {};
+            m_descriptorBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+            VK_STRUCTURE_CHAIN_ADD(m_features2, m_descriptorBufferFeatures);
+        }
         VK_STRUCTURE_CHAIN_END(m_features2);
         vkGetPhysicalDeviceFeatures2(m_handle, &m_features2);
     }
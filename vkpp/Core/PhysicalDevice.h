@@ -41,20 +41,22 @@ private:
 
 public:
     VkPhysicalDeviceProperties m_properties;
-    VkPhysicalDeviceProperties2 m_properties2;
-    VkPhysicalDeviceVulkan11Properties m_vk11Properties;
-    VkPhysicalDeviceVulkan12Properties m_vk12Properties;
-    VkPhysicalDeviceVulkan13Properties m_vk13Properties;
+    VkPhysicalDeviceProperties2 m_properties2 = {};
+    VkPhysicalDeviceVulkan11Properties m_vk11Properties = {};
+    VkPhysicalDeviceVulkan12Properties m_vk12Properties = {};
+    VkPhysicalDeviceVulkan13Properties m_vk13Properties = {};
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT m_descriptorBufferProperties = {};
     std::vector<VkQueueFamilyProperties> m_queueFamilies;
     VkPhysicalDeviceMemoryProperties m_memoryProperties;
     std::vector<VkExtensionProperties> m_extensions;
 
     VkPhysicalDeviceFeatures m_features;
-    VkPhysicalDeviceFeatures2 m_features2;
-    VkPhysicalDeviceVulkan11Features m_vk11Features;
-    VkPhysicalDeviceVulkan12Features m_vk12Features;
-    VkPhysicalDeviceVulkan13Features m_vk13Features;
+    VkPhysicalDeviceFeatures2 m_features2 = {};
+    VkPhysicalDeviceVulkan11Features m_vk11Features = {};
+    VkPhysicalDeviceVulkan12Features m_vk12Features = {};
+    VkPhysicalDeviceVulkan13Features m_vk13Features = {};
     VkPhysicalDeviceFragmentShaderBarycentricFeaturesKHR m_barycentricFeatures = {};
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT m_descriptorBufferFeatures = {};
 
 }; // class PhysicalDevice
 
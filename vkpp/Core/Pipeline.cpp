@@ -130,7 +130,7 @@ const VkGraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::Setup()
     m_pipelineInfo = {};
     m_pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     m_pipelineInfo.pNext = nullptr;
-    m_pipelineInfo.flags = 0;
+    m_pipelineInfo.flags = m_flags;
 
     VK_STRUCTURE_CHAIN_BEGIN(m_pipelineInfo);
 
@@ -352,7 +352,7 @@ const VkComputePipelineCreateInfo& ComputePipelineCreateInfo::Setup()
     m_pipelineInfo = {};
     m_pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     m_pipelineInfo.pNext = nullptr;
-    m_pipelineInfo.flags = 0;
+    m_pipelineInfo.flags = m_flags;
     m_pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     m_pipelineInfo.stage.pNext = nullptr;
     m_pipelineInfo.stage.flags = 0;
@@ -368,6 +368,26 @@ const VkComputePipelineCreateInfo& ComputePipelineCreateInfo::Setup()
     {
         m_pipelineInfo.stage.pSpecializationInfo = nullptr;
     }
+
+    const PhysicalDevice* physicalDevice = m_device->GetPhysicalDevice();
+    const VkPhysicalDeviceVulkan13Properties& vk13Properties = physicalDevice->m_vk13Properties;
+    if ((m_requiredSubgroupSize > 0) &&
+        physicalDevice->m_vk13Features.subgroupSizeControl &&
+        rad::HasBits<uint32_t>(vk13Properties.requiredSubgroupSizeStages, VK_SHADER_STAGE_COMPUTE_BIT) &&
+        (m_requiredSubgroupSize >= vk13Properties.minSubgroupSize) &&
+        (m_requiredSubgroupSize <= vk13Properties.maxSubgroupSize))
+    {
+        m_requiredSubgroupSizeInfo = {};
+        m_requiredSubgroupSizeInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO;
+        m_requiredSubgroupSizeInfo.pNext = nullptr;
+        m_requiredSubgroupSizeInfo.requiredSubgroupSize = m_requiredSubgroupSize;
+        m_pipelineInfo.stage.pNext = &m_requiredSubgroupSizeInfo;
+    }
+    if (m_requireFullSubgroups && physicalDevice->m_vk13Features.computeFullSubgroups)
+    {
+        m_pipelineInfo.stage.flags |= VK_PIPELINE_SHADER_STAGE_CREATE_REQUIRE_FULL_SUBGROUPS_BIT;
+    }
+
     m_pipelineInfo.layout = m_layout ?
         m_layout->GetHandle() : VK_NULL_HANDLE;
     m_pipelineInfo.basePipelineHandle = m_basePipeline ?
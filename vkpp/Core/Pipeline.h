@@ -228,6 +228,8 @@ public:
         VK_DYNAMIC_STATE_SCISSOR,
     };
 
+    // VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT if the layout uses descriptor buffers.
+    VkPipelineCreateFlags       m_flags = 0;
     rad::Ref<PipelineLayout>    m_layout;
     rad::Ref<RenderPass>        m_renderPass;
     uint32_t                    m_subpass = 0;
@@ -247,17 +249,26 @@ private:
     Device* m_device;
     VkComputePipelineCreateInfo m_pipelineInfo = {};
     VkSpecializationInfo m_specializationInfo = {};
+    VkPipelineShaderStageRequiredSubgroupSizeCreateInfo m_requiredSubgroupSizeInfo = {};
 public:
     ComputePipelineCreateInfo(Device* device);
     ~ComputePipelineCreateInfo();
 
+    // The subgroup size options are ignored if the device doesn't support them
+    // (subgroupSizeControl, computeFullSubgroups, or the size is out of range).
     const VkComputePipelineCreateInfo& Setup();
 
     rad::Ref<ShaderModule>          m_shaderModule;
     rad::Ref<SpecializationInfo>    m_shaderSpecialization;
+    // VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT if the layout uses descriptor buffers.
+    VkPipelineCreateFlags           m_flags = 0;
     rad::Ref<PipelineLayout>        m_layout;
     rad::Ref<Pipeline>              m_basePipeline;
     int32_t                         m_basePipelineIndex = 0;
+    // Power of two in [minSubgroupSize, maxSubgroupSize], 0 to let the implementation choose.
+    uint32_t                        m_requiredSubgroupSize = 0;
+    // All subgroups are full: the workgroup size x must be a multiple of the subgroup size.
+    bool                            m_requireFullSubgroups = false;
 
 }; // struct ComputePipelineCreateInfo
 
@@ -0,0 +1,39 @@
+#include <vkpp/Core/QueryPool.h>
+#include <vkpp/Core/Device.h>
+
+namespace vkpp
+{
+
+QueryPool::QueryPool(rad::Ref<Device> device, const VkQueryPoolCreateInfo& createInfo) :
+    m_device(std::move(device)),
+    m_queryType(createInfo.queryType),
+    m_queryCount(createInfo.queryCount)
+{
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkCreateQueryPool(m_device->GetHandle(), &createInfo, nullptr, &m_handle));
+}
+
+QueryPool::~QueryPool()
+{
+    if (m_handle != VK_NULL_HANDLE)
+    {
+        m_device->GetFunctionTable()->
+            vkDestroyQueryPool(m_device->GetHandle(), m_handle, nullptr);
+        m_handle = VK_NULL_HANDLE;
+    }
+}
+
+bool QueryPool::GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t* results,
+    VkQueryResultFlags flags)
+{
+    assert(firstQuery + queryCount <= m_queryCount);
+    VkResult result = m_device->GetFunctionTable()->vkGetQueryPoolResults(
+        m_device->GetHandle(), m_handle, firstQuery, queryCount,
+        sizeof(uint64_t) * queryCount, results, sizeof(uint64_t),
+        flags | VK_QUERY_RESULT_64_BIT);
+    // VK_NOT_READY if any result is not available without VK_QUERY_RESULT_WAIT_BIT.
+    VK_CHECK(result);
+    return (result == VK_SUCCESS);
+}
+
+} // namespace vkpp
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vkpp/Core/Common.h>
+
+namespace vkpp
+{
+
+class QueryPool : public rad::RefCounted<QueryPool>
+{
+public:
+    QueryPool(rad::Ref<Device> device, const VkQueryPoolCreateInfo& createInfo);
+    ~QueryPool();
+    VKPP_DISABLE_COPY_AND_MOVE(QueryPool);
+
+    VkQueryPool GetHandle() const { return m_handle; }
+    VkQueryType GetQueryType() const { return m_queryType; }
+    uint32_t GetQueryCount() const { return m_queryCount; }
+
+    // Read 64-bit results of queries [firstQuery, firstQuery + queryCount);
+    // wait for the results to be available by default.
+    bool GetResults(uint32_t firstQuery, uint32_t queryCount, uint64_t* results,
+        VkQueryResultFlags flags = VK_QUERY_RESULT_WAIT_BIT);
+
+private:
+    rad::Ref<Device> m_device;
+    VkQueryPool m_handle = VK_NULL_HANDLE;
+    VkQueryType m_queryType;
+    uint32_t m_queryCount = 0;
+
+}; // class QueryPool
+
+} // namespace vkpp
@@ -12,13 +12,15 @@
 namespace vkpp
 {
 
-Queue::Queue(rad::Ref<Device> device, QueueFamily queueFamily) :
-    m_device(std::move(device))
+Queue::Queue(rad::Ref<Device> device, QueueFamily queueFamily, uint32_t queueIndex) :
+    m_device(std::move(device)),
+    m_queueFamily(queueFamily),
+    m_queueIndex(queueIndex)
 {
     uint32_t queueFamilyIndex = m_device->GetQueueFamilyIndex(queueFamily);
     m_device->GetFunctionTable()->
         vkGetDeviceQueue(m_device->GetHandle(),
-            queueFamilyIndex, 0, &m_handle);
+            queueFamilyIndex, queueIndex, &m_handle);
 }
 
 Queue::~Queue()
@@ -51,6 +53,11 @@ bool Queue::SupportCompute() const
     return rad::HasBits<uint32_t>(GetQueueFamilyProperties().queueFlags, VK_QUEUE_COMPUTE_BIT);
 }
 
+bool Queue::SupportSparseBinding() const
+{
+    return rad::HasBits<uint32_t>(GetQueueFamilyProperties().queueFlags, VK_QUEUE_SPARSE_BINDING_BIT);
+}
+
 void Queue::Submit(
     rad::Span<CommandBuffer*>   commandBuffers,
     rad::Span<SubmitWaitInfo>   waits,
@@ -88,6 +95,61 @@ void Queue::Submit(
     submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphoresHandles.size());
     submitInfo.pSignalSemaphores = signalSemaphoresHandles.data();
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkQueueSubmit(m_handle, 1, &submitInfo, fence ? fence->GetHandle() : VK_NULL_HANDLE));
+}
+
+void Queue::Submit(
+    rad::Span<CommandBuffer*>       commandBuffers,
+    rad::Span<TimelineWaitInfo>     waits,
+    rad::Span<TimelineSignalInfo>   signals,
+    Fence* fence)
+{
+    rad::SmallVector<VkCommandBuffer, 8> commandBufferHandles(commandBuffers.size());
+    for (int i = 0; i < commandBuffers.size(); i++)
+    {
+        commandBufferHandles[i] = commandBuffers[i]->GetHandle();
+    }
+
+    rad::SmallVector<VkSemaphore, 8> waitSemaphoreHandles(waits.size());
+    rad::SmallVector<uint64_t, 8> waitValues(waits.size());
+    rad::SmallVector<VkPipelineStageFlags, 8> waitDstStageMasks(waits.size());
+    for (int i = 0; i < waits.size(); i++)
+    {
+        waitSemaphoreHandles[i] = waits[i].semaphore->GetHandle();
+        waitValues[i] = waits[i].value;
+        waitDstStageMasks[i] = waits[i].dstStageMask;
+    }
+
+    rad::SmallVector<VkSemaphore, 8> signalSemaphoresHandles(signals.size());
+    rad::SmallVector<uint64_t, 8> signalValues(signals.size());
+    for (int i = 0; i < signals.size(); i++)
+    {
+        signalSemaphoresHandles[i] = signals[i].semaphore->GetHandle();
+        signalValues[i] = signals[i].value;
+    }
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.pNext = nullptr;
+    timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+    timelineInfo.pWaitSemaphoreValues = waitValues.data();
+    timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+    timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphoreHandles.size());
+    submitInfo.pWaitSemaphores = waitSemaphoreHandles.data();
+    submitInfo.pWaitDstStageMask = waitDstStageMasks.data();
+    submitInfo.commandBufferCount = static_cast<uint32_t>(commandBufferHandles.size());
+    submitInfo.pCommandBuffers = commandBufferHandles.data();
+    submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphoresHandles.size());
+    submitInfo.pSignalSemaphores = signalSemaphoresHandles.data();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
     VK_CHECK(m_device->GetFunctionTable()->
         vkQueueSubmit(m_handle, 1, &submitInfo, fence ? fence->GetHandle() : VK_NULL_HANDLE));
 }
@@ -102,9 +164,19 @@ void Queue::SubmitAndWait(
     fence->Wait();
 }
 
+void Queue::BindSparse(rad::Span<VkBindSparseInfo> bindInfos, Fence* fence)
+{
+    assert(SupportSparseBinding());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkQueueBindSparse(m_handle, static_cast<uint32_t>(bindInfos.size()), bindInfos.data(),
+            fence ? fence->GetHandle() : VK_NULL_HANDLE));
+}
+
 VkResult Queue::WaitIdle()
 {
-    return vkQueueWaitIdle(m_handle);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_device->GetFunctionTable()->vkQueueWaitIdle(m_handle);
 }
 
 VkResult Queue::Present(
@@ -139,6 +211,7 @@ VkResult Queue::Present(
     presentInfo.pImageIndices = imageIndices.data();
     presentInfo.pResults = pResults;
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     return m_device->GetFunctionTable()->
         vkQueuePresentKHR(m_handle, &presentInfo);
 }
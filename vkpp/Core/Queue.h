@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vkpp/Core/Common.h>
+#include <mutex>
 
 namespace vkpp
 {
@@ -11,10 +12,25 @@ struct SubmitWaitInfo
     VkPipelineStageFlags dstStageMask;
 };
 
+// Wait until a timeline semaphore reaches the value.
+struct TimelineWaitInfo
+{
+    Semaphore* semaphore;
+    uint64_t value;
+    VkPipelineStageFlags dstStageMask;
+};
+
+// Set a timeline semaphore to the value when the commands complete.
+struct TimelineSignalInfo
+{
+    Semaphore* semaphore;
+    uint64_t value;
+};
+
 class Queue : public rad::RefCounted<Queue>
 {
 public:
-    Queue(rad::Ref<Device> device, QueueFamily queueFamily);
+    Queue(rad::Ref<Device> device, QueueFamily queueFamily, uint32_t queueIndex = 0);
     ~Queue();
     VKPP_DISABLE_COPY_AND_MOVE(Queue);
 
@@ -22,9 +38,12 @@ public:
 
     QueueFamily GetQueueFamily() const;
     uint32_t GetQueueFamilyIndex() const;
+    // Index of the queue in its family.
+    uint32_t GetQueueIndex() const { return m_queueIndex; }
     const VkQueueFamilyProperties& GetQueueFamilyProperties() const;
     bool SupportGraphics() const;
     bool SupportCompute() const;
+    bool SupportSparseBinding() const;
 
     void Submit(
         rad::Span<CommandBuffer*>   commandBuffers,
@@ -33,6 +52,14 @@ public:
         Fence* fence = nullptr
     );
 
+    // Submit with timeline semaphores (Device::CreateTimelineSemaphore).
+    void Submit(
+        rad::Span<CommandBuffer*>       commandBuffers,
+        rad::Span<TimelineWaitInfo>     waits,
+        rad::Span<TimelineSignalInfo>   signals,
+        Fence* fence = nullptr
+    );
+
     // Create a fence implicitly; wait the GPU to complete the commands and notify the host.
     void SubmitAndWait(
         rad::Span<CommandBuffer*>   commandBuffers,
@@ -40,6 +67,9 @@ public:
         rad::Span<Semaphore*>       signalSemaphores = {}
     );
 
+    // Bind memory to sparse resources (VK_QUEUE_SPARSE_BINDING_BIT), see SparsePageTable.
+    void BindSparse(rad::Span<VkBindSparseInfo> bindInfos, Fence* fence = nullptr);
+
     VkResult WaitIdle();
 
     VkResult Present(
@@ -54,7 +84,10 @@ public:
 private:
     rad::Ref<Device>        m_device;
     QueueFamily             m_queueFamily = QueueFamilyUniversal;
+    uint32_t                m_queueIndex = 0;
     VkQueue                 m_handle = VK_NULL_HANDLE;
+    // Queue operations require external synchronization.
+    std::mutex              m_mutex;
 
 }; // class Queue
 
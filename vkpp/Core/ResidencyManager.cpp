@@ -0,0 +1,157 @@
+#include <vkpp/Core/ResidencyManager.h>
+#include <vkpp/Core/PhysicalDevice.h>
+#include <vkpp/Core/Device.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+void ResidencyManager::SortLeastRecentlyUsed(std::vector<Candidate>& candidates)
+{
+    // Larger resources first among the ones last used in the same frame: fewer evictions.
+    std::sort(candidates.begin(), candidates.end(),
+        [](const Candidate& lhs, const Candidate& rhs)
+        {
+            if (lhs.lastUsedFrame != rhs.lastUsedFrame)
+            {
+                return (lhs.lastUsedFrame < rhs.lastUsedFrame);
+            }
+            return (lhs.size > rhs.size);
+        });
+}
+
+ResidencyManager::ResidencyManager(rad::Ref<Device> device, float budgetRatio, uint32_t frameLatency) :
+    m_device(std::move(device)),
+    m_budgetRatio(std::clamp(budgetRatio, 0.0f, 1.0f)),
+    m_frameLatency(frameLatency),
+    m_evictionPolicy(SortLeastRecentlyUsed)
+{
+    if (!m_device->IsMemoryBudgetSupported())
+    {
+        VKPP_LOG(warn, "ResidencyManager: VK_EXT_memory_budget is not supported, "
+            "the budget is estimated and ignores other processes.");
+    }
+}
+
+ResidencyManager::~ResidencyManager()
+{
+}
+
+void ResidencyManager::SetEvictionPolicy(EvictionPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_evictionPolicy = policy ? std::move(policy) : EvictionPolicy(SortLeastRecentlyUsed);
+}
+
+std::vector<ResidencyManager::HeapBudget> ResidencyManager::GetDeviceLocalHeapBudgets() const
+{
+    const VkPhysicalDeviceMemoryProperties& memoryProperties =
+        m_device->GetPhysicalDevice()->m_memoryProperties;
+    std::vector<VmaBudget> budgets = m_device->GetHeapBudgets();
+    std::vector<HeapBudget> heapBudgets;
+    for (uint32_t heapIndex = 0; heapIndex < memoryProperties.memoryHeapCount; ++heapIndex)
+    {
+        if (rad::HasBits<uint32_t>(memoryProperties.memoryHeaps[heapIndex].flags,
+            VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+        {
+            heapBudgets.push_back({ heapIndex, budgets[heapIndex].usage, budgets[heapIndex].budget });
+        }
+    }
+    return heapBudgets;
+}
+
+void ResidencyManager::Register(ResidentResource* resource)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[resource];
+    entry.lastUsedFrame = m_frameIndex;
+    entry.isResident = true;
+}
+
+void ResidencyManager::Unregister(ResidentResource* resource)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(resource);
+}
+
+bool ResidencyManager::IsResident(ResidentResource* resource)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_entries.find(resource);
+    return (iter != m_entries.end()) && iter->second.isResident;
+}
+
+bool ResidencyManager::MakeResident(ResidentResource* resource)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_entries.find(resource);
+    if (iter == m_entries.end())
+    {
+        VKPP_LOG(err, "ResidencyManager::MakeResident: the resource is not registered!");
+        return false;
+    }
+    Entry& entry = iter->second;
+    entry.lastUsedFrame = m_frameIndex;
+    if (!entry.isResident)
+    {
+        // The heap may become oversubscribed: resources are evicted on the next Update.
+        entry.isResident = resource->Restore();
+    }
+    return entry.isResident;
+}
+
+VkDeviceSize ResidencyManager::Update()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_frameIndex;
+    // Budgets are refreshed by VMA when the frame index changes.
+    vmaSetCurrentFrameIndex(m_device->GetAllocator(), static_cast<uint32_t>(m_frameIndex));
+
+    // Resources do not tell which heap they are allocated from: free the largest excess.
+    VkDeviceSize excess = 0;
+    for (const HeapBudget& heapBudget : GetDeviceLocalHeapBudgets())
+    {
+        const VkDeviceSize limit = static_cast<VkDeviceSize>(double(heapBudget.budget) * m_budgetRatio);
+        if (heapBudget.usage > limit)
+        {
+            excess = std::max(excess, heapBudget.usage - limit);
+        }
+    }
+    if (excess == 0)
+    {
+        return 0;
+    }
+
+    std::vector<Candidate> candidates;
+    for (const auto& [resource, entry] : m_entries)
+    {
+        if (entry.isResident && (entry.lastUsedFrame + m_frameLatency <= m_frameIndex))
+        {
+            candidates.push_back({ resource, resource->GetResidentSize(), entry.lastUsedFrame });
+        }
+    }
+    m_evictionPolicy(candidates);
+
+    VkDeviceSize evictedSize = 0;
+    for (const Candidate& candidate : candidates)
+    {
+        if (evictedSize >= excess)
+        {
+            break;
+        }
+        if (candidate.resource->Evict())
+        {
+            m_entries[candidate.resource].isResident = false;
+            evictedSize += candidate.size;
+        }
+    }
+    if (evictedSize < excess)
+    {
+        VKPP_LOG(warn, "ResidencyManager: device memory is oversubscribed by {} bytes, "
+            "{} bytes can be evicted.", excess, evictedSize);
+    }
+    return evictedSize;
+}
+
+} // namespace vkpp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vkpp/Core/Common.h>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace vkpp
+{
+
+// A resource whose device local memory can be released under memory pressure (demoted to host memory,
+// or dropped if it can be recreated), and restored when used again; see ResidencyManager.
+class ResidentResource
+{
+public:
+    virtual ~ResidentResource() = default;
+
+    // Device local memory released by Evict.
+    virtual VkDeviceSize GetResidentSize() const = 0;
+    // Return false if the resource cannot be evicted (the memory is not released).
+    virtual bool Evict() = 0;
+    // Return false if the resource cannot be restored into device local memory.
+    virtual bool Restore() = 0;
+
+}; // class ResidentResource
+
+// Keep the device local memory used within the budget of the heaps (VK_EXT_memory_budget if supported):
+// when a heap is oversubscribed, resources not used recently are evicted in the order of the eviction policy
+// (least recently used first by default), and restored on demand by MakeResident.
+// Resources must be registered while they exist. Thread-safe.
+class ResidencyManager : public rad::RefCounted<ResidencyManager>
+{
+public:
+    struct Candidate
+    {
+        ResidentResource* resource;
+        VkDeviceSize size;
+        // The frame index of the last MakeResident.
+        uint64_t lastUsedFrame;
+    };
+    // Sort the candidates: the first ones are evicted first.
+    using EvictionPolicy = std::function<void(std::vector<Candidate>& candidates)>;
+    static void SortLeastRecentlyUsed(std::vector<Candidate>& candidates);
+
+    // @param budgetRatio: the fraction of the budget of each device local heap that can be used,
+    // to leave room for the allocations between updates.
+    // @param frameLatency: the number of frames that can be in flight: the resources used in these frames
+    // are not evicted.
+    ResidencyManager(rad::Ref<Device> device, float budgetRatio = 0.9f, uint32_t frameLatency = 2);
+    ~ResidencyManager();
+    VKPP_DISABLE_COPY_AND_MOVE(ResidencyManager);
+
+    void SetEvictionPolicy(EvictionPolicy policy);
+
+    // Usage and budget of the device local heaps.
+    struct HeapBudget
+    {
+        uint32_t heapIndex;
+        VkDeviceSize usage;
+        VkDeviceSize budget;
+    };
+    std::vector<HeapBudget> GetDeviceLocalHeapBudgets() const;
+
+    // A resource is resident when registered.
+    void Register(ResidentResource* resource);
+    void Unregister(ResidentResource* resource);
+    bool IsResident(ResidentResource* resource);
+    // Mark the resource used in the current frame, and restore it if evicted;
+    // return false if the resource cannot be restored (it stays usable if demoted to host memory).
+    bool MakeResident(ResidentResource* resource);
+
+    uint64_t GetFrameIndex() const { return m_frameIndex; }
+    // Start a new frame and evict resources if the device local heaps are over budget;
+    // return the size of the memory evicted.
+    VkDeviceSize Update();
+
+private:
+    struct Entry
+    {
+        uint64_t lastUsedFrame = 0;
+        bool isResident = true;
+    };
+
+    rad::Ref<Device> m_device;
+    float m_budgetRatio = 0.9f;
+    uint32_t m_frameLatency = 2;
+    EvictionPolicy m_evictionPolicy;
+    std::mutex m_mutex;
+    std::unordered_map<ResidentResource*, Entry> m_entries;
+    uint64_t m_frameIndex = 0;
+
+}; // class ResidencyManager
+
+} // namespace vkpp
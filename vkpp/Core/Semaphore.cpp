@@ -22,4 +22,38 @@ Semaphore::~Semaphore()
     }
 }
 
+uint64_t Semaphore::GetCounterValue() const
+{
+    uint64_t value = 0;
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkGetSemaphoreCounterValue(m_device->GetHandle(), m_handle, &value));
+    return value;
+}
+
+VkResult Semaphore::Wait(uint64_t value, uint64_t timeout)
+{
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.pNext = nullptr;
+    waitInfo.flags = 0;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_handle;
+    waitInfo.pValues = &value;
+    VkResult waitResult = m_device->GetFunctionTable()->
+        vkWaitSemaphores(m_device->GetHandle(), &waitInfo, timeout);
+    VK_CHECK(waitResult);
+    return waitResult;
+}
+
+void Semaphore::Signal(uint64_t value)
+{
+    VkSemaphoreSignalInfo signalInfo = {};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    signalInfo.pNext = nullptr;
+    signalInfo.semaphore = m_handle;
+    signalInfo.value = value;
+    VK_CHECK(m_device->GetFunctionTable()->
+        vkSignalSemaphore(m_device->GetHandle(), &signalInfo));
+}
+
 } // namespace vkpp
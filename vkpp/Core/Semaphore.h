@@ -14,6 +14,14 @@ public:
 
     VkSemaphore GetHandle() const { return m_handle; }
 
+    // Timeline semaphores only (Device::CreateTimelineSemaphore).
+    uint64_t GetCounterValue() const;
+    // Wait on the host until the counter reaches the value; return VK_TIMEOUT if the timeout expires.
+    // @param timeout: in nanoseconds.
+    VkResult Wait(uint64_t value, uint64_t timeout = UINT64_MAX);
+    // Set the counter on the host; the value must be greater than the current value.
+    void Signal(uint64_t value);
+
 private:
     rad::Ref<Device> m_device;
     VkSemaphore m_handle = VK_NULL_HANDLE;
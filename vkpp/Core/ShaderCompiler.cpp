@@ -87,6 +87,12 @@ std::vector<uint32_t> ShaderCompiler::CompileGLSL(
     std::unique_ptr<FileIncluder> includer(
         RAD_NEW FileIncluder(&m_fileFinder));
     options.SetIncluder(std::move(includer));
+    if (m_targetVulkanVersion != 0)
+    {
+        uint32_t version = VK_MAKE_API_VERSION(0,
+            VK_API_VERSION_MAJOR(m_targetVulkanVersion), VK_API_VERSION_MINOR(m_targetVulkanVersion), 0);
+        options.SetTargetEnvironment(shaderc_target_env_vulkan, version);
+    }
 
     shaderc::SpvCompilationResult result =
         m_compiler.CompileGlslToSpv(source, GetShaderKind(stage), fileName.c_str(), options);
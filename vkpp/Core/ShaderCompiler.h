@@ -49,6 +49,10 @@ public:
         m_fileFinder.search_path().push_back(std::move(includeDir));
     }
 
+    // Target Vulkan version (VK_API_VERSION_1_x) of the generated SPIR-V; 0 for the default (Vulkan 1.0).
+    // Subgroup operations require Vulkan 1.1 or later.
+    void SetTargetVulkanVersion(uint32_t apiVersion) { m_targetVulkanVersion = apiVersion; }
+
     std::string PreprocessGLSL(
         VkShaderStageFlagBits stage, const std::string& fileName, const std::string& source,
         const std::string& entryPoint = "main", rad::Span<ShaderMacro> macros = {});
@@ -63,6 +67,7 @@ private:
     shaderc::Compiler m_compiler;
     std::string m_log;
     FileFinder m_fileFinder;
+    uint32_t m_targetVulkanVersion = 0;
 
 }; // class ShaderCompiler
 
@@ -0,0 +1,164 @@
+#include <vkpp/Core/SparsePageTable.h>
+#include <vkpp/Core/Device.h>
+#include <vkpp/Core/Queue.h>
+#include <vkpp/Core/Fence.h>
+
+#include <algorithm>
+
+namespace vkpp
+{
+
+SparsePageTable::SparsePageTable(rad::Ref<Device> device, VkBuffer buffer) :
+    m_device(std::move(device)),
+    m_buffer(buffer)
+{
+    m_device->GetFunctionTable()->
+        vkGetBufferMemoryRequirements(m_device->GetHandle(), m_buffer, &m_memoryRequirements);
+    // The size of sparse buffers is a multiple of the sparse block size (the alignment).
+    m_pages.resize(m_memoryRequirements.size / m_memoryRequirements.alignment, nullptr);
+}
+
+SparsePageTable::~SparsePageTable()
+{
+    // The buffer is destroyed before: the memory can be freed without unbinding.
+    for (VmaAllocation& page : m_pages)
+    {
+        if (page)
+        {
+            vmaFreeMemory(m_device->GetAllocator(), page);
+            page = nullptr;
+        }
+    }
+}
+
+bool SparsePageTable::IsCommitted(VkDeviceSize offset, VkDeviceSize size)
+{
+    if (size == 0)
+    {
+        return true;
+    }
+    const uint64_t firstPage = offset / GetPageSize();
+    const uint64_t lastPage = std::min<uint64_t>((offset + size - 1) / GetPageSize(), m_pages.size() - 1);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (uint64_t pageIndex = firstPage; pageIndex <= lastPage; ++pageIndex)
+    {
+        if (!m_pages[pageIndex])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SparsePageTable::Commit(Queue* queue, VkDeviceSize offset, VkDeviceSize size)
+{
+    if (size == 0)
+    {
+        return true;
+    }
+    const VkDeviceSize pageSize = GetPageSize();
+    const uint64_t firstPage = offset / pageSize;
+    const uint64_t lastPage = std::min<uint64_t>((offset + size - 1) / pageSize, m_pages.size() - 1);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<uint64_t> pageIndices;
+    for (uint64_t pageIndex = firstPage; pageIndex <= lastPage; ++pageIndex)
+    {
+        if (!m_pages[pageIndex])
+        {
+            pageIndices.push_back(pageIndex);
+        }
+    }
+    if (pageIndices.empty())
+    {
+        return true;
+    }
+
+    VkMemoryRequirements pageRequirements = m_memoryRequirements;
+    pageRequirements.size = pageSize;
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    std::vector<VmaAllocation> allocations(pageIndices.size(), nullptr);
+    std::vector<VmaAllocationInfo> allocInfos(pageIndices.size());
+    VkResult allocResult = vmaAllocateMemoryPages(m_device->GetAllocator(), &pageRequirements,
+        &allocCreateInfo, allocations.size(), allocations.data(), allocInfos.data());
+    if (allocResult != VK_SUCCESS)
+    {
+        VKPP_LOG(err, "SparsePageTable::Commit: failed to allocate {} page(s) of {} bytes: {}",
+            pageIndices.size(), pageSize, string_VkResult(allocResult));
+        return false;
+    }
+
+    std::vector<VkSparseMemoryBind> binds(pageIndices.size());
+    for (size_t i = 0; i < pageIndices.size(); ++i)
+    {
+        binds[i].resourceOffset = pageIndices[i] * pageSize;
+        binds[i].size = pageSize;
+        binds[i].memory = allocInfos[i].deviceMemory;
+        binds[i].memoryOffset = allocInfos[i].offset;
+        binds[i].flags = 0;
+        m_pages[pageIndices[i]] = allocations[i];
+    }
+    Bind(queue, binds);
+    m_committedPageCount += pageIndices.size();
+    return true;
+}
+
+void SparsePageTable::Decommit(Queue* queue, VkDeviceSize offset, VkDeviceSize size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    const VkDeviceSize pageSize = GetPageSize();
+    // Only the pages entirely in the range.
+    const uint64_t firstPage = (offset + pageSize - 1) / pageSize;
+    const uint64_t endPage = std::min<uint64_t>((offset + size) / pageSize, m_pages.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<VkSparseMemoryBind> binds;
+    std::vector<VmaAllocation> allocations;
+    for (uint64_t pageIndex = firstPage; pageIndex < endPage; ++pageIndex)
+    {
+        if (m_pages[pageIndex])
+        {
+            VkSparseMemoryBind bind = {};
+            bind.resourceOffset = pageIndex * pageSize;
+            bind.size = pageSize;
+            bind.memory = VK_NULL_HANDLE;
+            bind.memoryOffset = 0;
+            bind.flags = 0;
+            binds.push_back(bind);
+            allocations.push_back(m_pages[pageIndex]);
+            m_pages[pageIndex] = nullptr;
+        }
+    }
+    if (binds.empty())
+    {
+        return;
+    }
+    Bind(queue, binds);
+    vmaFreeMemoryPages(m_device->GetAllocator(), allocations.size(), allocations.data());
+    m_committedPageCount -= allocations.size();
+}
+
+void SparsePageTable::Bind(Queue* queue, rad::Span<VkSparseMemoryBind> binds)
+{
+    VkSparseBufferMemoryBindInfo bufferBindInfo = {};
+    bufferBindInfo.buffer = m_buffer;
+    bufferBindInfo.bindCount = static_cast<uint32_t>(binds.size());
+    bufferBindInfo.pBinds = binds.data();
+
+    VkBindSparseInfo bindInfo = {};
+    bindInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    bindInfo.pNext = nullptr;
+    bindInfo.bufferBindCount = 1;
+    bindInfo.pBufferBinds = &bufferBindInfo;
+
+    // Wait on the host: the commands submitted after to any queue see the new bindings.
+    rad::Ref<Fence> fence = m_device->CreateFence();
+    queue->BindSparse(bindInfo, fence.get());
+    fence->Wait();
+}
+
+} // namespace vkpp
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vkpp/Core/Common.h>
+#include <mutex>
+
+namespace vkpp
+{
+
+// Memory of a sparse buffer (created with VK_BUFFER_CREATE_SPARSE_BINDING_BIT and
+// VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT, see Device::CreateSparseStorageBuffer), committed by pages on demand:
+// the virtual size of the buffer can far exceed the memory committed.
+// Pages not committed have no memory: writes are discarded, reads return zero if
+// residencyNonResidentStrict is supported, undefined values otherwise.
+// Thread-safe.
+class SparsePageTable : public rad::RefCounted<SparsePageTable>
+{
+public:
+    SparsePageTable(rad::Ref<Device> device, VkBuffer buffer);
+    ~SparsePageTable();
+    VKPP_DISABLE_COPY_AND_MOVE(SparsePageTable);
+
+    // The sparse block size of the buffer.
+    VkDeviceSize GetPageSize() const { return m_memoryRequirements.alignment; }
+    uint64_t GetPageCount() const { return m_pages.size(); }
+    uint64_t GetCommittedPageCount() const { return m_committedPageCount; }
+    VkDeviceSize GetCommittedSize() const { return m_committedPageCount * GetPageSize(); }
+    bool IsCommitted(VkDeviceSize offset, VkDeviceSize size);
+
+    // Bind memory to the pages of the range not committed yet, and wait for the binding to complete.
+    // @param queue: must support sparse binding (Context::GetSparseBindingQueue).
+    bool Commit(Queue* queue, VkDeviceSize offset, VkDeviceSize size);
+    // Unbind and free the memory of the pages of the range (their content is lost),
+    // which must not be in use by the device.
+    void Decommit(Queue* queue, VkDeviceSize offset, VkDeviceSize size);
+
+private:
+    void Bind(Queue* queue, rad::Span<VkSparseMemoryBind> binds);
+
+    rad::Ref<Device> m_device;
+    VkBuffer m_buffer = VK_NULL_HANDLE;
+    VkMemoryRequirements m_memoryRequirements = {};
+    std::mutex m_mutex;
+    // The memory of each page, nullptr if not committed.
+    std::vector<VmaAllocation> m_pages;
+    uint64_t m_committedPageCount = 0;
+
+}; // class SparsePageTable
+
+} // namespace vkpp
@@ -9,6 +9,8 @@
 #include <rad/IO/File.h>
 #include <rad/IO/FileSystem.h>
 
+#include <algorithm>
+
 namespace vkpp
 {
 
@@ -20,6 +22,13 @@ SolidRenderer::SolidRenderer(rad::Ref<Context> context) :
 SolidRenderer::~SolidRenderer()
 {
     m_context->WaitIdle();
+    if (m_textureTable)
+    {
+        for (uint32_t slot : m_textureSlots)
+        {
+            m_textureTable->Free(slot);
+        }
+    }
 }
 
 bool SolidRenderer::Init()
@@ -32,6 +41,20 @@ bool SolidRenderer::Init()
     m_samplers[2] = device->CreatSamplerLinear(VK_SAMPLER_ADDRESS_MODE_REPEAT, 8.0f);
     m_samplers[3] = device->CreatSamplerLinear(VK_SAMPLER_ADDRESS_MODE_REPEAT, 16.0f);
 
+    if (device->IsBindlessTextureSupported())
+    {
+        rad::SmallVector<Sampler*, 4> samplers;
+        for (const rad::Ref<Sampler>& sampler : m_samplers)
+        {
+            samplers.push_back(sampler.get());
+        }
+        m_textureTable = RAD_NEW BindlessTextureTable(device);
+        if (!m_textureTable->Init(MaxTextureCount, samplers))
+        {
+            m_textureTable = nullptr;
+        }
+    }
+
     const VkExtent2D& resolution = m_context->m_resolution;
     Resize(resolution.width, resolution.height);
 
@@ -48,6 +71,16 @@ bool SolidRenderer::Init()
 
 bool SolidRenderer::LoadScene(Scene* scene)
 {
+    if (m_textureTable && !m_textureSlots.empty())
+    {
+        // The textures of the previous scene may be in use.
+        m_context->WaitIdle();
+        for (uint32_t slot : m_textureSlots)
+        {
+            m_textureTable->Free(slot);
+        }
+    }
+    m_textureSlots.clear();
     m_scene = scene;
 
     Device* device = m_context->GetDevice();
@@ -79,18 +112,26 @@ bool SolidRenderer::LoadScene(Scene* scene)
         }
         );
 
-    rad::SmallVector<VkSampler, 4> samplerHandles;
-    samplerHandles.resize(m_samplers.size());
-    for (size_t i = 0; i < samplerHandles.size(); ++i)
+    if (m_textureTable)
     {
-        samplerHandles[i] = m_samplers[i]->GetHandle();
+        // The layout of the table does not depend on the scene.
+        m_sceneDescSetLayout = m_textureTable->GetLayout();
     }
-    m_sceneDescSetLayout = device->CreateDescriptorSetLayout(
-        { // binding, type, count, stageFlags, samplers
-            { 0, VK_DESCRIPTOR_TYPE_SAMPLER, 4, VK_SHADER_STAGE_ALL_GRAPHICS, samplerHandles.data() },
-            { 1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, static_cast<uint32_t>(scene->m_image2Ds.size()), VK_SHADER_STAGE_ALL_GRAPHICS, nullptr},
+    else
+    {
+        rad::SmallVector<VkSampler, 4> samplerHandles;
+        samplerHandles.resize(m_samplers.size());
+        for (size_t i = 0; i < samplerHandles.size(); ++i)
+        {
+            samplerHandles[i] = m_samplers[i]->GetHandle();
         }
-        );
+        m_sceneDescSetLayout = device->CreateDescriptorSetLayout(
+            { // binding, type, count, stageFlags, samplers
+                { 0, VK_DESCRIPTOR_TYPE_SAMPLER, 4, VK_SHADER_STAGE_ALL_GRAPHICS, samplerHandles.data() },
+                { 1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, static_cast<uint32_t>(scene->m_image2Ds.size()), VK_SHADER_STAGE_ALL_GRAPHICS, nullptr},
+            }
+            );
+    }
     m_pipelineLayout = device->CreatePipelineLayout(
         { m_frameDescSetLayout.get(), m_sceneDescSetLayout.get() });
     GraphicsPipelineCreateInfo pipelineInfo(device);
@@ -127,20 +168,37 @@ bool SolidRenderer::LoadScene(Scene* scene)
     m_pipelines[RenderType::TriangleListTextured] =
         device->CreateGraphicsPipeline(pipelineInfo.Setup());
 
-    m_descPool = device->CreateDescriptorPool(swapchainImageCount + 1,
+    // Per set: the largest count of each type among the layouts; the allocator grows if more sets are needed.
+    m_descAllocator = RAD_NEW DescriptorAllocator(device,
         {
-            VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, swapchainImageCount },
+            VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2 },
             VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLER, 4 },
-            VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, static_cast<uint32_t>(scene->m_image2Ds.size()) },
-        });
+            VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                std::max(static_cast<uint32_t>(scene->m_image2Ds.size()), 1u) },
+        },
+        1, swapchainImageCount + 1);
     m_frameDescSets.resize(swapchainImageCount);
     for (size_t i = 0; i < m_frameDescSets.size(); ++i)
     {
-        m_frameDescSets[i] = m_descPool->Allocate(m_frameDescSetLayout.get());
+        m_frameDescSets[i] = m_descAllocator->Allocate(m_frameDescSetLayout.get());
+    }
+    if (m_textureTable)
+    {
+        m_sceneDescSet = m_textureTable->GetDescriptorSet();
+    }
+    else
+    {
+        m_sceneDescSet = m_descAllocator->Allocate(m_sceneDescSetLayout.get());
+        if (!m_sceneDescSet)
+        {
+            return false;
+        }
     }
-    m_sceneDescSet = m_descPool->Allocate(m_sceneDescSetLayout.get());
 
-    SetupResourceBindings();
+    if (!SetupResourceBindings())
+    {
+        return false;
+    }
 
     return true;
 }
@@ -154,9 +212,28 @@ bool SolidRenderer::SetupResourceBindings()
         m_frameDescSets[i]->UpdateBuffers(1, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
             VkDescriptorBufferInfo{ m_uniformBuffers[i]->GetHandle(), 0, sizeof(MeshInfo) });
     }
-    std::vector<VkImageLayout> imageLayouts(m_scene->m_image2Ds.size(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    m_sceneDescSet->UpdateImages(1, 0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-        m_scene->m_image2DViews, imageLayouts);
+    m_textureSlots.resize(m_scene->m_image2DViews.size());
+    if (m_textureTable)
+    {
+        for (size_t i = 0; i < m_textureSlots.size(); ++i)
+        {
+            m_textureSlots[i] = m_textureTable->Allocate(m_scene->m_image2DViews[i].get());
+            if (m_textureSlots[i] == BindlessTextureTable::InvalidSlot)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        std::vector<VkImageLayout> imageLayouts(m_scene->m_image2Ds.size(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        m_sceneDescSet->UpdateImages(1, 0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            m_scene->m_image2DViews, imageLayouts);
+        for (size_t i = 0; i < m_textureSlots.size(); ++i)
+        {
+            m_textureSlots[i] = static_cast<uint32_t>(i);
+        }
+    }
     return true;
 }
 
@@ -213,7 +290,7 @@ void SolidRenderer::Render(CommandBuffer* cmdBuffer, SceneNode* node)
         Material* material = mesh->m_material.get();
         if (TextureInfo* textureInfo = material->m_baseColorTexture.get())
         {
-            meshInfo.baseColorTextureIndex = textureInfo->imageIndex;
+            meshInfo.baseColorTextureIndex = m_textureSlots[textureInfo->imageIndex];
             meshInfo.baseColorSamplerIndex = 3; // sampler index
             meshInfo.baseColorUVIndex = textureInfo->uvIndex;
             meshInfo.baseColorLodBias = 0.0f;
@@ -50,9 +50,15 @@ public:
     rad::Ref<DescriptorSetLayout> m_sceneDescSetLayout;
     rad::Ref<PipelineLayout> m_pipelineLayout;
     std::map<RenderType, rad::Ref<Pipeline>> m_pipelines;
-    rad::Ref<DescriptorPool> m_descPool;
+    rad::Ref<DescriptorAllocator> m_descAllocator;
     std::vector<rad::Ref<DescriptorSet>> m_frameDescSets;
     rad::Ref<DescriptorSet> m_sceneDescSet;
+    // Textures of all scenes (nullptr if bindless textures are not supported):
+    // m_sceneDescSetLayout and m_sceneDescSet are the layout and set of the table.
+    static constexpr uint32_t MaxTextureCount = 4096;
+    rad::Ref<BindlessTextureTable> m_textureTable;
+    // Slot of each image of the scene (m_image2Ds) in the texture table.
+    std::vector<uint32_t> m_textureSlots;
 
     std::vector<rad::Ref<Sampler>> m_samplers;
     Scene* m_scene = nullptr;
@@ -55,14 +55,18 @@ bool Mesh::Upload()
         m_indexBuffer = device->CreateIndexBuffer(m_indexBufferSize);
     }
 
-    rad::Ref<Buffer> vertexStagingBuffer = device->CreateStagingBuffer(m_vertexBufferSize);
-    rad::Ref<Buffer> indexStagingBuffer;
-    if (m_indexBufferSize > 0)
+    // Write host visible buffers (see Device::SetDirectUploadEnabled) directly, others through staging buffers.
+    rad::Ref<Buffer> vertexStagingBuffer;
+    uint8_t* pVertexStaging = nullptr;
+    if (m_vertexBuffer->IsHostVisible())
     {
-        indexStagingBuffer = device->CreateStagingBuffer(m_indexBufferSize);
+        pVertexStaging = (uint8_t*)m_vertexBuffer->MapMemory(m_vertexBufferOffset, m_vertexBufferSize);
+    }
+    else
+    {
+        vertexStagingBuffer = device->CreateStagingBuffer(m_vertexBufferSize);
+        pVertexStaging = (uint8_t*)vertexStagingBuffer->MapMemory();
     }
-
-    uint8_t* pVertexStaging = (uint8_t*)vertexStagingBuffer->MapMemory();
 
     if ((m_renderType == RenderType::PointList) ||
         (m_renderType == RenderType::LineList))
@@ -117,13 +121,31 @@ bool Mesh::Upload()
         }
     }
 
-    vertexStagingBuffer->UnmapMemory();
+    Buffer* vertexDest = vertexStagingBuffer ? vertexStagingBuffer.get() : m_vertexBuffer.get();
+    if (!vertexDest->IsHostCoherent())
+    {
+        vertexDest->FlushAllocation(
+            vertexStagingBuffer ? 0 : m_vertexBufferOffset, m_vertexBufferSize);
+    }
+    vertexDest->UnmapMemory();
 
+    rad::Ref<Buffer> indexStagingBuffer;
     if (m_indexBufferSize > 0)
     {
-        uint8_t* pIndexStaging = (uint8_t*)indexStagingBuffer->MapMemory();
-        memcpy(pIndexStaging, m_indices.data(), m_indexBufferSize);
-        indexStagingBuffer->UnmapMemory();
+        if (m_indexBuffer->IsHostVisible())
+        {
+            m_indexBuffer->Write(m_indices.data(), m_indexBufferOffset, m_indexBufferSize);
+        }
+        else
+        {
+            indexStagingBuffer = device->CreateStagingBuffer(m_indexBufferSize);
+            indexStagingBuffer->Write(m_indices.data(), 0, m_indexBufferSize);
+        }
+    }
+
+    if (!vertexStagingBuffer && !indexStagingBuffer)
+    {
+        return true;
     }
 
     QueueFamily queueFamily = QueueFamilyUniversal;
@@ -132,16 +154,22 @@ bool Mesh::Upload()
 
     rad::Ref<CommandBuffer> cmdBuffer = cmdPool->Allocate();
     cmdBuffer->Begin();
-    VkBufferCopy copyVertexRegion = {};
-    copyVertexRegion.srcOffset = 0;
-    copyVertexRegion.dstOffset = m_vertexBufferOffset;
-    copyVertexRegion.size = m_vertexBufferSize;
-    cmdBuffer->CopyBuffer(vertexStagingBuffer.get(), m_vertexBuffer.get(), copyVertexRegion);
-    VkBufferCopy copyIndexRegion = {};
-    copyIndexRegion.srcOffset = 0;
-    copyIndexRegion.dstOffset = m_indexBufferOffset;
-    copyIndexRegion.size = m_indexBufferSize;
-    cmdBuffer->CopyBuffer(indexStagingBuffer.get(), m_indexBuffer.get(), copyIndexRegion);
+    if (vertexStagingBuffer)
+    {
+        VkBufferCopy copyVertexRegion = {};
+        copyVertexRegion.srcOffset = 0;
+        copyVertexRegion.dstOffset = m_vertexBufferOffset;
+        copyVertexRegion.size = m_vertexBufferSize;
+        cmdBuffer->CopyBuffer(vertexStagingBuffer.get(), m_vertexBuffer.get(), copyVertexRegion);
+    }
+    if (indexStagingBuffer)
+    {
+        VkBufferCopy copyIndexRegion = {};
+        copyIndexRegion.srcOffset = 0;
+        copyIndexRegion.dstOffset = m_indexBufferOffset;
+        copyIndexRegion.size = m_indexBufferSize;
+        cmdBuffer->CopyBuffer(indexStagingBuffer.get(), m_indexBuffer.get(), copyIndexRegion);
+    }
     cmdBuffer->End();
     context->GetQueue(queueFamily)->SubmitAndWait(cmdBuffer.get());
 
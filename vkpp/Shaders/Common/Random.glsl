@@ -0,0 +1,59 @@
+// Counter-based random number generation.
+// Parallel Random Numbers: As Easy as 1, 2, 3 (Salmon et al., SC'11)
+// https://www.thesalmons.org/john/random123/papers/random123sc11.pdf
+
+#define PHILOX_M4x32_0 0xD2511F53u
+#define PHILOX_M4x32_1 0xCD9E8D57u
+#define PHILOX_W32_0 0x9E3779B9u
+#define PHILOX_W32_1 0xBB67AE85u
+
+uvec4 Philox4x32Round(uvec4 ctr, uvec2 key)
+{
+    uint hi0, lo0, hi1, lo1;
+    umulExtended(PHILOX_M4x32_0, ctr.x, hi0, lo0);
+    umulExtended(PHILOX_M4x32_1, ctr.z, hi1, lo1);
+    return uvec4(hi1 ^ ctr.y ^ key.x, lo1, hi0 ^ ctr.w ^ key.y, lo0);
+}
+
+// Philox4x32-10: 4 random words for each (counter, key).
+uvec4 Philox4x32_10(uvec4 ctr, uvec2 key)
+{
+    for (int i = 0; i < 9; ++i)
+    {
+        ctr = Philox4x32Round(ctr, key);
+        key += uvec2(PHILOX_W32_0, PHILOX_W32_1);
+    }
+    return Philox4x32Round(ctr, key);
+}
+
+// [0, 1) with 24 bits of randomness.
+float UintToUniformFloat(uint x)
+{
+    return float(x >> 8) * (1.0 / 16777216.0);
+}
+
+// (0, 1], safe for log().
+float UintToUniformFloatPositive(uint x)
+{
+    return (float(x >> 8) + 1.0) * (1.0 / 16777216.0);
+}
+
+// Box-Muller transform: two independent standard normal values from two random words.
+vec2 BoxMuller(uint x, uint y)
+{
+    float r = sqrt(-2.0 * log(UintToUniformFloatPositive(x)));
+    float theta = 6.28318530717958647692 * UintToUniformFloat(y);
+    return vec2(r * cos(theta), r * sin(theta));
+}
+
+// Unbiased enough integer in [0, range) by multiply-high (Lemire); range = 0 means 2^32.
+uint UintToRange(uint x, uint range)
+{
+    if (range == 0)
+    {
+        return x;
+    }
+    uint hi, lo;
+    umulExtended(x, range, hi, lo);
+    return hi;
+}
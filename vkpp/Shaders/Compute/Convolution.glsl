@@ -0,0 +1,42 @@
+// Common definitions of convolution and pooling kernels.
+// Tensors are indexed as 5D (N, C, D, H, W); 4D tensors have D = 1.
+// CHANNEL_LAST: 1 for NHWC/NDHWC, 0 for NCHW/NCDHW; all tensors of a kernel share the layout,
+// and are contiguous (see ComputeKernel::GetSpatialShape).
+
+// Element offset of (n, c, d, h, w) in a tensor of sizes (*, C, D, H, W).
+uint GetOffset5D(uint n, uint c, uint d, uint h, uint w, uint C, uint D, uint H, uint W)
+{
+#if CHANNEL_LAST
+    return (((n * D + d) * H + h) * W + w) * C + c;
+#else
+    return (((n * C + c) * D + d) * H + h) * W + w;
+#endif
+}
+
+// Inverse of GetOffset5D: consecutive invocations process consecutive elements in memory.
+void GetCoord5D(uint offset, uint C, uint D, uint H, uint W,
+    out uint n, out uint c, out uint d, out uint h, out uint w)
+{
+#if CHANNEL_LAST
+    c = offset % C;
+    offset /= C;
+#endif
+    w = offset % W;
+    offset /= W;
+    h = offset % H;
+    offset /= H;
+    d = offset % D;
+    offset /= D;
+#if CHANNEL_LAST
+    n = offset;
+#else
+    c = offset % C;
+    n = offset / C;
+#endif
+}
+
+// Input coordinate of the output coordinate and the filter tap; negative if in padding.
+int GetInputCoord(uint outputCoord, uint filterCoord, uint stride, uint padding, uint dilation)
+{
+    return int(outputCoord * stride + filterCoord * dilation) - int(padding);
+}
@@ -0,0 +1,27 @@
+// Indices of gather/scatter kernels.
+// INDEX_TYPE_ID: Sint32 or Sint64, see ComputeKernel::AddDataTypeMacros.
+// Indices are read as 32-bit words (declared by the includer as uint g_indices[]),
+// so that 64-bit integer support is not required.
+
+// Return the index at offset (in elements), counted from the end if negative;
+// -1 if it is out of [-size, size).
+int GetIndex(uint offset, uint size)
+{
+#if (INDEX_TYPE_ID == DATA_TYPE_SINT64)
+    const uint lo = g_indices[offset * 2];
+    const uint hi = g_indices[offset * 2 + 1];
+    // Out of the 32-bit range if the high word is not the sign extension of the low word.
+    if (hi != uint(int(lo) >> 31))
+    {
+        return -1;
+    }
+    int index = int(lo);
+#else
+    int index = int(g_indices[offset]);
+#endif
+    if (index < 0)
+    {
+        index += int(size);
+    }
+    return ((index >= 0) && (uint(index) < size)) ? index : -1;
+}
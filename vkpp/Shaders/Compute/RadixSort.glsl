@@ -0,0 +1,89 @@
+// Common definitions of radix sort and radix select.
+// Keys are converted to "ordered bits": unsigned integers with the same order as the keys,
+// and processed in digits of RADIX_BITS from the least (sort) or most (select) significant digit.
+// Floating-point keys are ordered by their bits: -NaN < -Inf < ... < -0 < +0 < ... < +Inf < +NaN.
+// Requires GL_KHR_shader_subgroup_basic and GL_KHR_shader_subgroup_arithmetic,
+// and exactly RADIX_THREAD_COUNT invocations per workgroup.
+
+#define RADIX_BITS 8
+#define RADIX_SIZE 256
+#define RADIX_MASK 0xFFu
+// One invocation per digit in per-digit steps.
+#define RADIX_THREAD_COUNT RADIX_SIZE
+// Enough for the smallest subgroup size (4).
+#define RADIX_MAX_SUBGROUPS 64
+
+uint OrderedBitsFromFloat(float x)
+{
+    uint bits = floatBitsToUint(x);
+    // Flip all bits of negative values, and the sign bit of the others.
+    return bits ^ (uint(int(bits) >> 31) | 0x80000000u);
+}
+
+uint OrderedBitsFromInt(int x)
+{
+    return uint(x) ^ 0x80000000u;
+}
+
+uint64_t OrderedBitsFromDouble(double x)
+{
+    uint64_t bits = doubleBitsToUint64(x);
+    return bits ^ (uint64_t(int64_t(bits) >> 63) | 0x8000000000000000ul);
+}
+
+uint64_t OrderedBitsFromInt64(int64_t x)
+{
+    return uint64_t(x) ^ 0x8000000000000000ul;
+}
+
+// Sort keys (KEY_TYPE_ID: 32/64-bit integer or float), stored as RADIX_KEY bits.
+#if defined(KEY_TYPE_ID)
+#if IS_64BIT(KEY_TYPE_ID)
+#define RADIX_KEY uint64_t
+#define RADIX_PASS_COUNT 8
+#else
+#define RADIX_KEY uint
+#define RADIX_PASS_COUNT 4
+#endif
+
+RADIX_KEY GetSortKey(RADIX_KEY bits, bool descending)
+{
+#if (KEY_TYPE_ID == DATA_TYPE_FLOAT32)
+    RADIX_KEY key = OrderedBitsFromFloat(uintBitsToFloat(bits));
+#elif (KEY_TYPE_ID == DATA_TYPE_SINT32)
+    RADIX_KEY key = OrderedBitsFromInt(int(bits));
+#elif (KEY_TYPE_ID == DATA_TYPE_FLOAT64)
+    RADIX_KEY key = OrderedBitsFromDouble(uint64BitsToDouble(bits));
+#elif (KEY_TYPE_ID == DATA_TYPE_SINT64)
+    RADIX_KEY key = OrderedBitsFromInt64(int64_t(bits));
+#else
+    RADIX_KEY key = bits;
+#endif
+    return descending ? ~key : key;
+}
+#endif
+
+shared uint s_radixPartials[RADIX_MAX_SUBGROUPS];
+
+// Exclusive prefix sum over the workgroup (must be called in uniform control flow),
+// and the total in total.
+uint WorkgroupExclusiveAdd(uint x, out uint total)
+{
+    uint exclusive = subgroupExclusiveAdd(x);
+    // s_radixPartials may still be read by the previous call.
+    barrier();
+    if (gl_SubgroupInvocationID == gl_SubgroupSize - 1)
+    {
+        s_radixPartials[gl_SubgroupID] = exclusive + x;
+    }
+    barrier();
+    uint prefix = 0;
+    total = 0;
+    for (uint i = 0; i < gl_NumSubgroups; ++i)
+    {
+        uint partial = s_radixPartials[i];
+        prefix += (i < gl_SubgroupID) ? partial : 0;
+        total += partial;
+    }
+    return prefix + exclusive;
+}
@@ -0,0 +1,183 @@
+// Single-pass scan with decoupled look-back:
+// Single-pass Parallel Prefix Scan with Decoupled Look-back (Merrill & Garland, 2016)
+// https://research.nvidia.com/publication/2016-03_single-pass-parallel-prefix-scan-decoupled-look-back
+// Each workgroup scans tiles of SCAN_TILE_SIZE elements. Tile ids are taken from an atomic counter
+// in the order the workgroups start, so the predecessors of a tile are always running or done
+// and waiting for them makes progress regardless of the dispatch order.
+// Segmented scans restart at head flags; a tile that contains a head does not depend on its
+// predecessors, and publishes its inclusive prefix immediately.
+// The includer defines:
+// SCAN_TYPE: the value type, scanned by addition.
+// SCAN_TO_BITS(x), SCAN_FROM_BITS(x): bit casts between SCAN_TYPE and uint.
+// SCAN_STATE_BINDING: binding of the state buffer, which must be zeroed before each dispatch.
+// Requires GL_KHR_shader_subgroup_basic and GL_KHR_shader_subgroup_shuffle_relative,
+// and exactly SCAN_THREAD_COUNT invocations per workgroup.
+
+#define SCAN_THREAD_COUNT 256
+#define SCAN_ITEMS_PER_THREAD 8
+#define SCAN_TILE_SIZE (SCAN_THREAD_COUNT * SCAN_ITEMS_PER_THREAD)
+// Enough for the smallest subgroup size (4).
+#define SCAN_MAX_SUBGROUPS 64
+
+#define SCAN_STATUS_INVALID 0u
+#define SCAN_STATUS_AGGREGATE 1u
+#define SCAN_STATUS_PREFIX 2u
+
+struct ScanTileState
+{
+    uint status;
+    uint aggregate;     // SCAN_STATUS_AGGREGATE: reduction of the tile
+    uint prefix;        // SCAN_STATUS_PREFIX: inclusive prefix up to the end of the tile
+    uint reserved;
+};
+
+// Must match Scan::StateHeader.
+layout(set = 0, binding = SCAN_STATE_BINDING) coherent buffer ScanState
+{
+    uint g_tileCounter;
+    uint g_stateReserved[3];
+    ScanTileState g_tileStates[];
+};
+
+struct ScanValue
+{
+    SCAN_TYPE value;
+    bool head;          // a segment starts at or before the value
+};
+
+ScanValue ScanIdentity()
+{
+    return ScanValue(SCAN_TYPE(0), false);
+}
+
+// The operator of segmented scans, associative: (a, b) -> b if b starts a segment, otherwise a + b.
+ScanValue ScanCombine(ScanValue a, ScanValue b)
+{
+    return ScanValue(b.head ? b.value : (a.value + b.value), a.head || b.head);
+}
+
+ScanValue SubgroupInclusiveScan(ScanValue x)
+{
+    for (uint delta = 1; delta < gl_SubgroupSize; delta *= 2)
+    {
+        SCAN_TYPE value = subgroupShuffleUp(x.value, delta);
+        bool head = subgroupShuffleUp(x.head, delta);
+        if (gl_SubgroupInvocationID >= delta)
+        {
+            x = ScanCombine(ScanValue(value, head), x);
+        }
+    }
+    return x;
+}
+
+shared ScanValue s_subgroupPrefixes[SCAN_MAX_SUBGROUPS];
+shared ScanValue s_workgroupTotal;
+
+// Return the exclusive prefix of x in the workgroup, and the total in s_workgroupTotal.
+ScanValue WorkgroupExclusiveScan(ScanValue x)
+{
+    ScanValue inclusive = SubgroupInclusiveScan(x);
+    SCAN_TYPE previousValue = subgroupShuffleUp(inclusive.value, 1);
+    bool previousHead = subgroupShuffleUp(inclusive.head, 1);
+    ScanValue exclusive = (gl_SubgroupInvocationID > 0) ?
+        ScanValue(previousValue, previousHead) : ScanIdentity();
+
+    // The shared variables may still be read by the previous tile.
+    barrier();
+    if (gl_SubgroupInvocationID == gl_SubgroupSize - 1)
+    {
+        s_subgroupPrefixes[gl_SubgroupID] = inclusive;
+    }
+    barrier();
+    // A few subgroups only, scan them serially.
+    if (gl_LocalInvocationIndex == 0)
+    {
+        ScanValue running = ScanIdentity();
+        for (uint i = 0; i < gl_NumSubgroups; ++i)
+        {
+            ScanValue total = s_subgroupPrefixes[i];
+            s_subgroupPrefixes[i] = running;
+            running = ScanCombine(running, total);
+        }
+        s_workgroupTotal = running;
+    }
+    barrier();
+    return ScanCombine(s_subgroupPrefixes[gl_SubgroupID], exclusive);
+}
+
+void PublishTileState(uint tileId, uint status, SCAN_TYPE value)
+{
+    if (status == SCAN_STATUS_AGGREGATE)
+    {
+        g_tileStates[tileId].aggregate = SCAN_TO_BITS(value);
+    }
+    else
+    {
+        g_tileStates[tileId].prefix = SCAN_TO_BITS(value);
+    }
+    // The value must be visible before the status.
+    memoryBarrierBuffer();
+    atomicExchange(g_tileStates[tileId].status, status);
+}
+
+// Called by one invocation: publish the tile total and return the exclusive prefix of the tile.
+ScanValue LookBack(uint tileId, ScanValue total)
+{
+    if ((tileId == 0) || total.head)
+    {
+        PublishTileState(tileId, SCAN_STATUS_PREFIX, total.value);
+        return ScanIdentity();
+    }
+
+    PublishTileState(tileId, SCAN_STATUS_AGGREGATE, total.value);
+    // Tiles publishing aggregates have no heads, so only the values are accumulated.
+    SCAN_TYPE prefix = SCAN_TYPE(0);
+    int predecessor = int(tileId) - 1;
+    while (predecessor >= 0)
+    {
+        uint status = atomicOr(g_tileStates[predecessor].status, 0u);
+        if (status == SCAN_STATUS_INVALID)
+        {
+            // Not ready, spin.
+            continue;
+        }
+        memoryBarrierBuffer();
+        if (status == SCAN_STATUS_PREFIX)
+        {
+            prefix = SCAN_FROM_BITS(g_tileStates[predecessor].prefix) + prefix;
+            break;
+        }
+        prefix = SCAN_FROM_BITS(g_tileStates[predecessor].aggregate) + prefix;
+        --predecessor;
+    }
+    PublishTileState(tileId, SCAN_STATUS_PREFIX, prefix + total.value);
+    return ScanValue(prefix, false);
+}
+
+shared uint s_tileId;
+shared ScanValue s_tilePrefix;
+
+// Take the next tile of the workgroup (uniform), SCAN_TILE_SIZE elements from tileId * SCAN_TILE_SIZE.
+uint AcquireTile()
+{
+    // s_tileId may still be read by the previous tile.
+    barrier();
+    if (gl_LocalInvocationIndex == 0)
+    {
+        s_tileId = atomicAdd(g_tileCounter, 1);
+    }
+    barrier();
+    return s_tileId;
+}
+
+// Return the exclusive prefix of the items of the invocation, x is their reduction.
+ScanValue ScanTile(uint tileId, ScanValue x)
+{
+    ScanValue exclusive = WorkgroupExclusiveScan(x);
+    if (gl_LocalInvocationIndex == 0)
+    {
+        s_tilePrefix = LookBack(tileId, s_workgroupTotal);
+    }
+    barrier();
+    return ScanCombine(s_tilePrefix, exclusive);
+}
@@ -0,0 +1,88 @@
+// Common definitions of tensor kernels.
+// The 8/16/64-bit types are only enabled here; capabilities are required only if the types are used.
+#extension GL_EXT_shader_explicit_arithmetic_types : enable
+#extension GL_EXT_shader_16bit_storage : enable
+#extension GL_EXT_shader_8bit_storage : enable
+#extension GL_EXT_buffer_reference : enable
+
+// Must match Tensor::DataType.
+#define DATA_TYPE_UNDEFINED 0
+#define DATA_TYPE_FLOAT16   1
+#define DATA_TYPE_FLOAT32   2
+#define DATA_TYPE_FLOAT64   3
+#define DATA_TYPE_SINT8     4
+#define DATA_TYPE_SINT16    5
+#define DATA_TYPE_SINT32    6
+#define DATA_TYPE_SINT64    7
+#define DATA_TYPE_UINT8     8
+#define DATA_TYPE_UINT16    9
+#define DATA_TYPE_UINT32    10
+#define DATA_TYPE_UINT64    11
+#define DATA_TYPE_BFLOAT16  12
+
+#define IS_FLOATING_POINT(id) ((((id) >= DATA_TYPE_FLOAT16) && ((id) <= DATA_TYPE_FLOAT64)) || \
+    ((id) == DATA_TYPE_BFLOAT16))
+#define IS_64BIT(id) (((id) == DATA_TYPE_FLOAT64) || ((id) == DATA_TYPE_SINT64) || ((id) == DATA_TYPE_UINT64))
+#define DATA_TYPE_SIZE(id) (IS_64BIT(id) ? 8 : \
+    (((id) == DATA_TYPE_SINT8) || ((id) == DATA_TYPE_UINT8)) ? 1 : \
+    (((id) == DATA_TYPE_FLOAT16) || ((id) == DATA_TYPE_SINT16) || ((id) == DATA_TYPE_UINT16) || \
+        ((id) == DATA_TYPE_BFLOAT16)) ? 2 : 4)
+
+// SHADER_FLOAT16, SHADER_INT8: 1 if the device supports 16-bit float and 8-bit integer arithmetic,
+// defined by ComputeKernel::Init.
+
+// DEVICE_ADDRESS: 1 if the kernel takes its buffers by device address in the push constants instead of
+// descriptors (see ComputeKernel::SetDeviceAddressArguments), defined by ComputeKernel::Init.
+// The kernel declares a buffer reference type for each buffer, such as
+// layout(buffer_reference, std430, buffer_reference_align = DATA_TYPE_SIZE(DATA_TYPE_ID)) buffer ...;
+// BUFFER_ADDRESS(T) is the type of the push constant member of reference type T,
+// a placeholder of the same size (8 bytes) with descriptors, so that the layout is the same.
+#if DEVICE_ADDRESS
+#define BUFFER_ADDRESS(T) T
+#else
+#define BUFFER_ADDRESS(T) uvec2
+#endif
+
+// BFloat16 is stored as uint16_t, the high half of a float.
+float BFloat16ToFloat(uint x)
+{
+    return uintBitsToFloat(x << 16);
+}
+
+// Round to nearest even, must match Tensor::BFloat16FromFloat.
+uint FloatToBFloat16(float x)
+{
+    uint bits = floatBitsToUint(x);
+    if (isnan(x))
+    {
+        return (bits >> 16) | 0x40u;
+    }
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return bits >> 16;
+}
+
+// Convert DATA_TYPE loaded from memory to the arithmetic type T, and the reverse.
+#if defined(DATA_TYPE_ID) && (DATA_TYPE_ID == DATA_TYPE_BFLOAT16)
+#define LOAD_DATA_TYPE(T, x) T(BFloat16ToFloat(uint(x)))
+#define STORE_DATA_TYPE(x) DATA_TYPE(FloatToBFloat16(float(x)))
+#else
+#define LOAD_DATA_TYPE(T, x) T(x)
+#define STORE_DATA_TYPE(x) DATA_TYPE(x)
+#endif
+
+// Must match the limit of the host (ComputeKernel::MaxDimensions).
+#define TENSOR_MAX_DIMS 8
+
+// Element offset (in elements) of the logical (row major) index.
+uint GetTensorOffset(uint index, uint numDims,
+    uint sizes[TENSOR_MAX_DIMS], uint strides[TENSOR_MAX_DIMS])
+{
+    uint offset = 0;
+    for (int dim = int(numDims) - 1; dim >= 0; --dim)
+    {
+        uint size = sizes[dim];
+        offset += (index % size) * strides[dim];
+        index /= size;
+    }
+    return offset;
+}